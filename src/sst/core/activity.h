@@ -213,6 +213,14 @@ public:
         return priority;
     }
 
+#ifdef SST_ENFORCE_EVENT_ORDERING
+    /** Return the link order of this Activity.  Used by queues that
+     * cache the sort key rather than using the comparators above */
+    inline int32_t getEnforceLinkOrder() const {
+        return enforce_link_order;
+    }
+#endif
+
     /** Generic print-print function for this Activity.
      * Subclasses should override this function.
      */
@@ -231,31 +239,39 @@ public:
         queue_order = order;
     }
 
+    /** Return the Queue order */
+    inline uint64_t getQueueOrder() const {
+        return queue_order;
+    }
+
+    /** Usage of a single memory pool */
+    struct PoolUsage_t {
+        size_t size;            /*!< Size of the activities in the pool */
+        uint64_t bytes;         /*!< Bytes currently mapped */
+        uint64_t live;          /*!< Activities currently allocated */
+        uint64_t capacity;      /*!< Activities the mapped arenas can hold */
+        uint64_t reclaimed;     /*!< Bytes returned to the OS */
+    };
+
 #ifdef USE_MEMPOOL
     /** Allocates memory from a memory pool for a new Activity */
 	void* operator new(std::size_t size) throw()
     {
-        /* 1) Find memory pool
+        /* 1) Find this thread's memory pool for the size class
          * 1.5) If not found, create new
          * 2) Alloc item from pool
          * 3) Append PoolID to item, increment pointer
          */
+        size_t sizeClass = (size + poolClassSize - 1) / poolClassSize;
         Core::MemPool *pool = NULL;
-        size_t nPools = memPools.size();
-        std::thread::id tid = std::this_thread::get_id();
-        for ( size_t i = 0 ; i < nPools ; i++ ) {
-            PoolInfo_t &p = memPools[i];
-            if ( p.tid == tid && p.size == size ) {
-                pool = p.pool;
-                break;
+        if ( sizeClass < numPoolClasses ) {
+            pool = threadPools[sizeClass];
+            if ( NULL == pool ) {
+                pool = createPool(sizeClass * poolClassSize);
+                threadPools[sizeClass] = pool;
             }
-        }
-        if ( NULL == pool ) {
-            /* Still can't find it, alloc a new one */
-            pool = new Core::MemPool(size+sizeof(PoolData_t));
-
-            std::lock_guard<std::mutex> lock(poolMutex);
-            memPools.emplace_back(tid, size, pool);
+        } else {
+            pool = findPool(size);
         }
 
         PoolData_t *ptr = (PoolData_t*)pool->malloc();
@@ -271,28 +287,10 @@ public:
     /** Returns memory for this Activity to the appropriate memory pool */
 	void operator delete(void* ptr)
     {
-        /* 1) Decrement pointer
-         * 2) Determine Pool Pointer
-         * 2b) Set Pointer field to NULL to allow tracking
-         * 3) Return to pool
-         */
-        PoolData_t *ptr8 = ((PoolData_t*)ptr) - 1;
-        Core::MemPool* pool = *ptr8;
-        *ptr8 = NULL;
-
-        pool->free(ptr8);
+        freeToPool(ptr);
     }
     void operator delete(void* ptr, std::size_t UNUSED(sz)){
-        /* 1) Decrement pointer
-         * 2) Determine Pool Pointer
-         * 2b) Set Pointer field to NULL to allow tracking
-         * 3) Return to pool
-         */
-        PoolData_t *ptr8 = ((PoolData_t*)ptr) - 1;
-        Core::MemPool* pool = *ptr8;
-        *ptr8 = NULL;
-
-        pool->free(ptr8);
+        freeToPool(ptr);
     };
 
     static void getMemPoolUsage(uint64_t& bytes, uint64_t& active_activities) {
@@ -303,10 +301,45 @@ public:
             active_activities += entry.pool->getUndeletedEntries();
         }
     }
+
+    /** Get the usage of each memory pool in this process */
+    static void getMemPoolUsage(std::vector<PoolUsage_t>& usage) {
+        usage.clear();
+        for ( auto && entry : Activity::memPools ) {
+            PoolUsage_t u;
+            u.size = entry.size;
+            u.bytes = entry.pool->getBytesMemUsed();
+            u.live = entry.pool->getUndeletedEntries();
+            u.capacity = entry.pool->getCapacity();
+            u.reclaimed = entry.pool->getBytesReclaimed();
+            usage.push_back(u);
+        }
+    }
+
+    /** Get the number of activities freed by the thread that allocated
+     * them (local) and by some other thread (remote) */
+    static void getMemPoolFreeCounts(uint64_t& local_frees, uint64_t& remote_frees) {
+        local_frees = 0;
+        remote_frees = 0;
+        for ( auto && entry : Activity::memPools ) {
+            local_frees += entry.pool->getLocalFrees();
+            remote_frees += entry.pool->getRemoteFrees();
+        }
+    }
+
+    /** Reclaim the activities that other threads have freed back to the
+     * calling thread's pools */
+    static void drainRemoteFrees() {
+        size_t nPools = memPools.size();
+        for ( size_t i = 0 ; i < nPools ; i++ ) {
+            Core::MemPool* pool = memPools[i].pool;
+            if ( pool->isOwner(threadPools) ) pool->drainRemoteFrees();
+        }
+    }
     
     static void printUndeletedActivities(const std::string& header, Output &out, SimTime_t before = MAX_SIMTIME_T) {
         for ( auto && entry : Activity::memPools ) {
-            const std::list<uint8_t*>& arenas = entry.pool->getArenas();
+            const std::vector<uint8_t*>& arenas = entry.pool->getArenas();
             size_t arenaSize = entry.pool->getArenaSize();
             size_t elemSize = entry.pool->getElementSize();
             size_t nelem = arenaSize / elemSize;
@@ -374,6 +407,38 @@ private:
     };
     static std::mutex poolMutex;
 	static std::vector<PoolInfo_t> memPools;
+
+    /** Granularity of the size classes */
+    static const size_t poolClassSize = 8;
+    /** Number of size classes with a thread-local lookup.  Larger
+     * activities fall back to searching memPools. */
+    static const size_t numPoolClasses = 128;
+    /** This thread's pools, indexed by size class.  The address of
+     * the array also identifies the thread to its pools. */
+    static thread_local Core::MemPool* threadPools[numPoolClasses];
+
+    /** Create a pool owned by the calling thread and register it in memPools */
+    static Core::MemPool* createPool(size_t size);
+    /** Find (or create) the calling thread's pool for a large size */
+    static Core::MemPool* findPool(size_t size);
+
+    static inline void freeToPool(void* ptr)
+    {
+        /* 1) Decrement pointer
+         * 2) Determine Pool Pointer
+         * 2b) Set Pointer field to NULL to allow tracking
+         * 3) Return to this thread's cache, or the owner's return queue
+         */
+        PoolData_t *ptr8 = ((PoolData_t*)ptr) - 1;
+        Core::MemPool* pool = *ptr8;
+        *ptr8 = NULL;
+
+        if ( pool->isOwner(threadPools) ) {
+            pool->localFree(ptr8);
+        } else {
+            pool->free(ptr8);
+        }
+    }
 #endif
 };
 
@@ -96,7 +96,7 @@ void Clock::execute( void ) {
     }
     
     next = sim->getCurrentSimCycle() + period->getFactor();
-    sim->insertActivity( next, this );
+    sim->insertClock( next, this );
 
     return;
 }
@@ -120,10 +120,30 @@ Clock::schedule()
     }
 
     // std::cout << "Scheduling clock " << period->getFactor() << " at cycle " << next << " current cycle is " << sim->getCurrentSimCycle() << std::endl;
-    sim->insertActivity(next, this);
+    sim->insertClock(next, this);
     scheduled = true;
 }
 
+void
+Clock::saveState(State& state) const
+{
+    state.currentCycle = currentCycle;
+    state.handlers = staticHandlerMap;
+    state.next = next;
+    state.deliveryTime = getDeliveryTime();
+    state.scheduled = scheduled;
+}
+
+void
+Clock::restoreState(const State& state)
+{
+    currentCycle = state.currentCycle;
+    staticHandlerMap = state.handlers;
+    next = state.next;
+    setDeliveryTime(state.deliveryTime);
+    scheduled = state.scheduled;
+}
+
 void
 Clock::print(const std::string& header, Output &out) const
 {
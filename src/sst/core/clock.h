@@ -105,7 +105,7 @@ public:
 
     /**
      * Activates this clock object, by inserting into the simulation's
-     * timeVortex for future execution.
+     * clock scheduler for future execution.
      */
     void schedule();
 
@@ -118,6 +118,19 @@ public:
     bool unregisterHandler( Clock::HandlerBase* handler, bool& empty );
 
     void print(const std::string& header, Output &out) const override;
+
+    /** Tick count, handlers and schedule, saved so optimistic thread
+     * synchronization can roll the clock back */
+    struct State {
+        Cycle_t currentCycle;
+        std::vector<Clock::HandlerBase*> handlers;
+        SimTime_t next;
+        SimTime_t deliveryTime;
+        bool scheduled;
+    };
+
+    void saveState(State& state) const;
+    void restoreState(const State& state);
     
 private:
 /*     typedef std::list<Clock::HandlerBase*> HandlerMap_t; */
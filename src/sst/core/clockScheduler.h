@@ -0,0 +1,104 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_CLOCKSCHEDULER_H
+#define SST_CORE_CLOCKSCHEDULER_H
+
+#include <algorithm>
+#include <vector>
+
+#include <sst/core/clock.h>
+
+namespace SST {
+
+/**
+ * Holds the active Clocks of a Simulation, ordered by their next tick.
+ *
+ * There are only ever a handful of clock domains, so they are kept in
+ * a small sorted vector instead of going through the TimeVortex on
+ * every tick.  The run loop merges the head of this queue with the
+ * head of the TimeVortex.  The queue does not own the Clocks.
+ */
+class ClockScheduler {
+public:
+    ClockScheduler() : insertOrder(0) {}
+
+    /** Returns true if no clocks are scheduled */
+    bool empty() const { return clocks.empty(); }
+    /** Returns the number of scheduled clocks */
+    size_t size() const { return clocks.size(); }
+
+    /** Schedule a clock to fire at the given time */
+    void insert(SimTime_t time, Clock* clock) {
+        clock->setDeliveryTime(time);
+        Entry entry = { time, clock->getPriority(), insertOrder++, clock };
+        // Latest entry first, so the next clock is at the back
+        clocks.insert(std::upper_bound(clocks.begin(), clocks.end(), entry), entry);
+    }
+
+    /** Returns the next clock to fire */
+    Clock* front() const { return clocks.back().clock; }
+
+    /** Removes and returns the next clock to fire */
+    Clock* pop() {
+        Clock* ret = clocks.back().clock;
+        clocks.pop_back();
+        return ret;
+    }
+
+    /** Returns the time of the next clock tick */
+    SimTime_t getNextTime() const {
+        return clocks.empty() ? MAX_SIMTIME_T : clocks.back().time;
+    }
+
+    /** Returns true if the next clock should fire before act.  Clocks
+     * have a link order of 0 and on a complete tie go first.
+     */
+    bool before(const Activity* act) const {
+        if ( clocks.empty() ) return false;
+        const Entry& next = clocks.back();
+        if ( next.time != act->getDeliveryTime() ) return next.time < act->getDeliveryTime();
+        if ( next.priority != act->getPriority() ) return next.priority < act->getPriority();
+#ifdef SST_ENFORCE_EVENT_ORDERING
+        return act->getEnforceLinkOrder() >= 0;
+#else
+        return true;
+#endif
+    }
+
+    /** Print the scheduled clocks */
+    void print(Output& out) const {
+        for ( auto it = clocks.rbegin(); it != clocks.rend(); ++it ) {
+            it->clock->print("  ", out);
+        }
+    }
+
+private:
+    struct Entry {
+        SimTime_t time;
+        int       priority;
+        uint64_t  order;
+        Clock*    clock;
+
+        bool operator<(const Entry& rhs) const {
+            if ( time != rhs.time ) return time > rhs.time;
+            if ( priority != rhs.priority ) return priority > rhs.priority;
+            return order > rhs.order;
+        }
+    };
+
+    std::vector<Entry> clocks;
+    uint64_t insertOrder;
+};
+
+} //namespace SST
+
+#endif // SST_CORE_CLOCKSCHEDULER_H
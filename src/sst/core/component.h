@@ -109,6 +109,27 @@ public:
     */
     void primaryComponentOKToEndSim();
 
+    /** Returns true if this component can be rolled back by
+        optimistic thread synchronization (--thread-sync=optimistic).
+        A component that returns true must save and restore all of
+        its state, including that of its SubComponents, in
+        serializeState().  It must not use polling links or OneShot
+        handlers, and output written while handling events may be
+        repeated after a rollback.  If any component on the rank
+        returns false, the rank runs conservatively.
+
+        @sa Component::serializeState()
+    */
+    virtual bool supportsRollback() const { return false; }
+
+    /** Save (when packing) or restore (when unpacking) the state a
+        rollback has to undo.  Called at the start of each optimistic
+        window and again if the window is rolled back.
+
+        @sa Component::supportsRollback()
+    */
+    virtual void serializeState(SST::Core::Serialization::serializer& UNUSED(ser)) {}
+
 
 protected:
     friend class SubComponent;
@@ -59,6 +59,8 @@ Config::Config(RankInfo rankInfo)
     generator   = "NONE";
     generator_options   = "";
     timeVortex  = "sst.timevortex.priority_queue";
+    threadSync  = "simple";
+    rankSyncEncoding = "raw";
     dump_component_graph_file = "";
 
     char* wd_buf = (char*) malloc( sizeof(char) * PATH_MAX );
@@ -79,10 +81,17 @@ Config::Config(RankInfo rankInfo)
     output_core_prefix = "@x SST Core: ";
     print_timing = false;
     print_env = false;
+    thread_direct_delivery = false;
+    adaptive_sync = false;
+    split_rank_sync = false;
+    barrier_spin = "auto";
 
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     event_dump_file = "";
 #endif
+#ifdef USE_MEMPOOL
+    mempool_hugepages = "none";
+#endif
 
     // Some config items can be initialized from either the command line or
     // the config file. The command line has precedence. We need to initialize
@@ -122,6 +131,9 @@ static const struct sstLongOpts_s sstOptions[] = {
     DEF_FLAGOPT("no-env-config",            0,      "disable SST environment configuration", &Config::disableEnvConfig),
     DEF_FLAGOPT("print-timing-info",        0,      "print SST timing information", &Config::enablePrintTiming),
     DEF_FLAGOPT("print-env",                0,      "print SST environment vairable", &Config::enablePrintEnv),
+    DEF_FLAGOPT("thread-direct-delivery",   0,      "resolve the receiving link of cross-thread events when they are sent, so thread syncs only merge them into the TimeVortex", &Config::enableThreadDirectDelivery),
+    DEF_FLAGOPT("adaptive-sync",            0,      "schedule each sync at the earliest time any partition could send to another, instead of one lookahead past the next activity", &Config::enableAdaptiveSync),
+    DEF_FLAGOPT("split-rank-sync",          0,      "post each rank sync exchange and finish it at the next sync, so ranks keep running while it is in flight", &Config::enableSplitRankSync),
     /* HiddenNoConfigDesc */
     DEF_ARGOPT("sdl-file",          "FILE",         "SST Configuration file", &Config::setConfigFile),
     DEF_ARGOPT("stopAtCycle",       "TIME",         "set time at which simulation will end execution", &Config::setStopAt),
@@ -138,6 +150,8 @@ static const struct sstLongOpts_s sstOptions[] = {
     DEF_ARGOPT("generator",         "GENERATOR",    "select the generator to be used to build simulation <lib.generatorName>", &Config::setGenerator),
     DEF_ARGOPT("gen-options",       "OPTSTIRNG",    "options to be passed to generator function", &Config::setGeneratorOptions),
     DEF_ARGOPT("timeVortex ",       "MODULE",       "select TimeVortex implementation <lib.timevortex>", &Config::setTimeVortex),
+    DEF_ARGOPT("thread-sync",       "MODE",         "select thread synchronization: simple (all-thread barrier), pairwise (handshake only with linked threads), cmb (null messages between linked threads) or optimistic (speculative windows with rollback, single rank only)", &Config::setThreadSync),
+    DEF_ARGOPT("rank-sync-encoding", "MODE",        "select the wire encoding of events sent between ranks: raw (default), compact (delta and varint encoded) or compressed (compact, then zlib for large batches)", &Config::setRankSyncEncoding),
     DEF_ARGOPT("output-directory",  "DIR",          "directory into which all SST output files should reside", &Config::setOutputDir),
     DEF_ARGOPT("output-config",     "FILE",         "file to write SST configuration (in Python format)", &Config::setWriteConfig),
     DEF_ARGOPT("output-dot",        "FILE",         "file to write SST configuration graph (in GraphViz format)", &Config::setWriteDot),
@@ -147,9 +161,11 @@ static const struct sstLongOpts_s sstOptions[] = {
     DEF_ARGOPT("output-prefix-core","STR",          "set the SST::Output prefix for the core", &Config::setOutputPrefix),
 #ifdef USE_MEMPOOL
     DEF_ARGOPT("output-undeleted-events",   "FILE", "file to write information about all undeleted events at the end of simulation (STDOUT and STDERR can be used to output to console)", &Config::setWriteUndeleted),
+    DEF_ARGOPT("mempool-hugepages", "MODE",         "back memory pool arenas with huge pages: none, transparent or explicit (explicit falls back to transparent)", &Config::setMemPoolHugePages),
 #endif
     DEF_ARGOPT("model-options",     "STR",          "provide options to the python configuration script", &Config::setModelOptions),
     DEF_ARGOPT_SHORT("num_threads", 'n',   "NUM",   "number of parallel threads to use per rank", &Config::setNumThreads),
+    DEF_ARGOPT("barrier-spin",      "COUNT",        "number of times a thread polls a thread barrier before sleeping on it; auto (default) is 1024, or 0 when there are more threads than cores", &Config::setBarrierSpin),
     {{NULL, 0, 0, 0}, NULL, NULL, NULL, NULL}
 };
 static const size_t nLongOpts = (sizeof(sstOptions) / sizeof(sstLongOpts_s)) -1;
@@ -467,6 +483,24 @@ bool Config::setTimeVortex(const std::string &arg) {
     return true;
 }
 
+bool Config::setThreadSync(const std::string &arg) {
+    if ( arg != "simple" && arg != "pairwise" && arg != "cmb" && arg != "optimistic" ) return false;
+    threadSync = arg;
+    return true;
+}
+
+bool Config::setRankSyncEncoding(const std::string &arg) {
+    if ( arg != "raw" && arg != "compact" && arg != "compressed" ) return false;
+#ifndef HAVE_LIBZ
+    if ( arg == "compressed" ) {
+        fprintf(stderr, "compressed rank sync encoding requires SST to be built with libz\n");
+        return false;
+    }
+#endif
+    rankSyncEncoding = arg;
+    return true;
+}
+
 bool Config::setOutputDir(const std::string &arg) { output_directory = arg ;  return true; }
 bool Config::setWriteConfig(const std::string &arg) { output_config_graph = arg;  return true; }
 bool Config::setWriteDot(const std::string &arg) { output_dot = arg; return true; }
@@ -476,6 +510,11 @@ bool Config::setWritePartition(const std::string &arg) { dump_component_graph_fi
 bool Config::setOutputPrefix(const std::string &arg) { output_core_prefix = arg; return true; }
 #ifdef USE_MEMPOOL
 bool Config::setWriteUndeleted(const std::string &arg) { event_dump_file = arg; return true; }
+bool Config::setMemPoolHugePages(const std::string &arg) {
+    if ( arg != "none" && arg != "transparent" && arg != "explicit" ) return false;
+    mempool_hugepages = arg;
+    return true;
+}
 #endif
 
 bool Config::setModelOptions(const std::string &arg) {
@@ -510,6 +549,22 @@ bool Config::setNumThreads(const std::string &arg) {
     return false;
 }
 
+bool Config::setBarrierSpin(const std::string &arg) {
+    if ( arg == "auto" ) {
+        barrier_spin = arg;
+        return true;
+    }
+    errno = E_OK;
+    char* end = NULL;
+    unsigned long spin = strtoul(arg.c_str(), &end, 0);
+    if ( errno == E_OK && end != arg.c_str() && *end == '\0' && spin <= UINT32_MAX ) {
+        barrier_spin = arg;
+        return true;
+    }
+    fprintf(stderr, "Failed to parse [%s] as a barrier spin count\n", arg.c_str());
+    return false;
+}
+
 
 
 /* Getters */
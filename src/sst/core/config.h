@@ -67,6 +67,8 @@ public:
     std::string     generator;          /*!< Generator to use */
     std::string     generator_options;  /*!< Options to pass to the generator */
     std::string     timeVortex;         /*!< TimeVortex implementation to use */
+    std::string     threadSync;         /*!< Thread synchronization algorithm (simple, pairwise, cmb, optimistic) */
+    std::string     rankSyncEncoding;   /*!< Wire encoding of rank sync data (raw, compact, compressed) */
     std::string     output_config_graph;  /*!< File to dump configuration graph */
     std::string     output_dot;         /*!< File to dump dot output */
     std::string     output_xml;         /*!< File to dump XML output */
@@ -82,9 +84,14 @@ public:
     bool            enable_sig_handling; /*!< Enable signal handling */
     bool            print_timing;       /*!< Print SST timing information */
     bool            print_env;          /*!< Print SST environment */
+    bool            thread_direct_delivery; /*!< Tag cross-thread events with their receiving Link when sent */
+    bool            adaptive_sync;      /*!< Schedule syncs from each partition's earliest possible send */
+    bool            split_rank_sync;    /*!< Overlap the rank sync exchange with execution */
+    std::string     barrier_spin;       /*!< Times a thread polls a barrier before sleeping, or "auto" */
 
 #ifdef USE_MEMPOOL
     std::string     event_dump_file;    /*!< File to dump undeleted events to */
+    std::string     mempool_hugepages;  /*!< Huge page mode for memory pool arenas */
 #endif
 
 
@@ -99,6 +106,9 @@ public:
     bool disableEnvConfig()     { no_env_config = true; return true;}
     bool enablePrintTiming()    { print_timing = true; return true;}
     bool enablePrintEnv()       { print_env = true; return true; }
+    bool enableThreadDirectDelivery() { thread_direct_delivery = true; return true; }
+    bool enableAdaptiveSync() { adaptive_sync = true; return true; }
+    bool enableSplitRankSync() { split_rank_sync = true; return true; }
 
     bool setConfigFile(const std::string &arg);
     bool setDebugFile(const std::string &arg);
@@ -113,6 +123,8 @@ public:
     bool setGenerator(const std::string &arg);
     bool setGeneratorOptions(const std::string &arg);
     bool setTimeVortex(const std::string &arg);
+    bool setThreadSync(const std::string &arg);
+    bool setRankSyncEncoding(const std::string &arg);
     bool setOutputDir(const std::string &arg);
     bool setWriteConfig(const std::string &arg);
     bool setWriteDot(const std::string &arg);
@@ -122,9 +134,11 @@ public:
     bool setOutputPrefix(const std::string &arg);
 #ifdef USE_MEMPOOL
     bool setWriteUndeleted(const std::string &arg);
+    bool setMemPoolHugePages(const std::string &arg);
 #endif
     bool setModelOptions(const std::string &arg);
     bool setNumThreads(const std::string &arg);
+    bool setBarrierSpin(const std::string &arg);
 
 
     Simulation::Mode_t getRunMode() { return runMode; }
@@ -31,7 +31,7 @@ void Event::execute(void)
 }
 
 Event* Event::clone() {
-    Simulation::getSimulation()->getSimulationOutput().
+    Simulation::getSimulationOutput().
         fatal(CALL_INFO,1,"Called clone() on an Event that doesn't"
               " implement it.");            
     return NULL;  // Never reached, but gets rid of compiler warning
@@ -54,6 +54,27 @@ void NullEvent::execute(void)
 #ifdef USE_MEMPOOL
 std::mutex Activity::poolMutex;
 std::vector<Activity::PoolInfo_t> Activity::memPools;
+thread_local Core::MemPool* Activity::threadPools[Activity::numPoolClasses];
+
+Core::MemPool* Activity::createPool(size_t size)
+{
+    Core::MemPool* pool = new Core::MemPool(size+sizeof(PoolData_t), (2<<20), threadPools);
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+    memPools.emplace_back(std::this_thread::get_id(), size, pool);
+    return pool;
+}
+
+Core::MemPool* Activity::findPool(size_t size)
+{
+    std::thread::id tid = std::this_thread::get_id();
+    size_t nPools = memPools.size();
+    for ( size_t i = 0 ; i < nPools ; i++ ) {
+        PoolInfo_t &p = memPools[i];
+        if ( p.tid == tid && p.size == size ) return p.pool;
+    }
+    return createPool(size);
+}
 #endif
 
 
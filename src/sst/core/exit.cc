@@ -133,6 +133,26 @@ unsigned int Exit::getRefCount() {
     return m_refCount;
 }
 
+void Exit::saveState(State& state)
+{
+    std::lock_guard<Spinlock> lock(slock);
+    state.refCount = m_refCount;
+    state.threadCounts.assign(m_thread_counts, m_thread_counts + num_threads);
+    state.idSet = m_idSet;
+    state.endTime = end_time;
+}
+
+void Exit::restoreState(const State& state)
+{
+    std::lock_guard<Spinlock> lock(slock);
+    m_refCount = state.refCount;
+    for ( int i = 0; i < num_threads; i++ ) {
+        m_thread_counts[i] = state.threadCounts[i];
+    }
+    m_idSet = state.idSet;
+    end_time = state.endTime;
+}
+
 
 void
 Exit::execute()
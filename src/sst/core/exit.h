@@ -16,6 +16,7 @@
 
 #include <unordered_set>
 #include <cinttypes>
+#include <vector>
 
 #include <sst/core/action.h>
 
@@ -70,6 +71,25 @@ public:
         return global_count;
     }
 
+    /** Record the result of an exit check that a RankSync reduced
+     * along with its own data, in place of calling check() */
+    void setGlobalCount(unsigned int count, SimTime_t end) {
+        global_count = count;
+        end_time = end;
+    }
+
+    /** Reference counts and end time, saved so optimistic thread
+     * synchronization can undo refInc() and refDec() calls */
+    struct State {
+        unsigned int refCount;
+        std::vector<unsigned int> threadCounts;
+        std::unordered_set<ComponentId_t> idSet;
+        SimTime_t endTime;
+    };
+
+    void saveState(State& state);
+    void restoreState(const State& state);
+
 private:
     Exit() { } // for serialization only
     Exit(const Exit&);           // Don't implement
@@ -17,6 +17,8 @@
 #include "sst/core/simulation.h"
 #include "sst/core/timeConverter.h"
 
+#include <map>
+
 #include <sst/core/warnmacros.h>
 #ifdef SST_CONFIG_HAVE_MPI
 DISABLE_WARN_MISSING_OVERRIDE
@@ -69,28 +71,45 @@ void SimulatorHeartbeat::execute( void )
 
     uint64_t mempool_size = 0;
     uint64_t active_activities = 0;
+    uint64_t local_frees = 0, remote_frees = 0;
+    uint64_t mempool_capacity = 0, mempool_reclaimed = 0;
+    // Per size usage of this rank's pools, summed over threads
+    std::map<size_t, Activity::PoolUsage_t> pool_usage;
 #ifdef USE_MEMPOOL
     Activity::getMemPoolUsage(mempool_size, active_activities);
+    Activity::getMemPoolFreeCounts(local_frees, remote_frees);
+    std::vector<Activity::PoolUsage_t> usage;
+    Activity::getMemPoolUsage(usage);
+    for ( auto && u : usage ) {
+        mempool_capacity += u.capacity;
+        mempool_reclaimed += u.reclaimed;
+        auto it = pool_usage.find(u.size);
+        if ( it == pool_usage.end() ) {
+            pool_usage[u.size] = u;
+        } else {
+            it->second.bytes += u.bytes;
+            it->second.live += u.live;
+            it->second.capacity += u.capacity;
+            it->second.reclaimed += u.reclaimed;
+        }
+    }
 #endif
     uint64_t max_mempool_size, global_mempool_size, global_active_activities;
+    uint64_t global_local_frees, global_remote_frees;
+    uint64_t global_mempool_capacity, global_mempool_reclaimed;
     
-#ifdef SST_CONFIG_HAVE_MPI
     uint64_t local_sync_data_size = Simulation::getSimulation()->getSyncQueueDataSize();
 
-    MPI_Allreduce(&local_max_tv_depth, &global_max_tv_depth, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&local_sync_data_size, &global_max_sync_data_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&local_sync_data_size, &global_sync_data_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-    MPI_Allreduce(&mempool_size, &max_mempool_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&mempool_size, &global_mempool_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-    MPI_Allreduce(&active_activities, &global_active_activities, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-#else
-    global_max_tv_depth = local_max_tv_depth;
-    global_max_sync_data_size = 0;
-    global_max_sync_data_size = 0;
-    max_mempool_size = mempool_size;
-    global_mempool_size = mempool_size;
-    global_active_activities = active_activities;
-#endif
+    global_max_tv_depth = Comms::all_reduce(local_max_tv_depth, Comms::REDUCE_MAX);
+    global_max_sync_data_size = Comms::all_reduce(local_sync_data_size, Comms::REDUCE_MAX);
+    global_sync_data_size = Comms::all_reduce(local_sync_data_size, Comms::REDUCE_SUM);
+    max_mempool_size = Comms::all_reduce(mempool_size, Comms::REDUCE_MAX);
+    global_mempool_size = Comms::all_reduce(mempool_size, Comms::REDUCE_SUM);
+    global_active_activities = Comms::all_reduce(active_activities, Comms::REDUCE_SUM);
+    global_local_frees = Comms::all_reduce(local_frees, Comms::REDUCE_SUM);
+    global_remote_frees = Comms::all_reduce(remote_frees, Comms::REDUCE_SUM);
+    global_mempool_capacity = Comms::all_reduce(mempool_capacity, Comms::REDUCE_SUM);
+    global_mempool_reclaimed = Comms::all_reduce(mempool_reclaimed, Comms::REDUCE_SUM);
 
         
     if ( rank == 0 ) {
@@ -107,6 +126,9 @@ void SimulatorHeartbeat::execute( void )
         
         sprintf(ua_buffer, "%" PRIu64 "B", global_mempool_size);
         UnitAlgebra global_mempool_size_ua(ua_buffer);
+
+        sprintf(ua_buffer, "%" PRIu64 "B", global_mempool_reclaimed);
+        UnitAlgebra global_mempool_reclaimed_ua(ua_buffer);
         
         sim_output.output("\tMax mempool usage:               %s\n",
                           max_mempool_size_ua.toStringBestSI().c_str());
@@ -114,6 +136,23 @@ void SimulatorHeartbeat::execute( void )
                           global_mempool_size_ua.toStringBestSI().c_str());
         sim_output.output("\tGlobal active activities         %" PRIu64 " activities\n",
                           global_active_activities);
+        sim_output.output("\tGlobal local activity frees     %" PRIu64 " activities\n",
+                          global_local_frees);
+        sim_output.output("\tGlobal remote activity frees    %" PRIu64 " activities\n",
+                          global_remote_frees);
+        sim_output.output("\tGlobal mempool free slots       %.1f%%\n",
+                          global_mempool_capacity == 0 ? 0.0 :
+                          100.0 * (global_mempool_capacity - global_active_activities) / global_mempool_capacity);
+        sim_output.output("\tGlobal mempool reclaimed:       %s\n",
+                          global_mempool_reclaimed_ua.toStringBestSI().c_str());
+        for ( auto && entry : pool_usage ) {
+            const Activity::PoolUsage_t& u = entry.second;
+            sprintf(ua_buffer, "%" PRIu64 "B", u.bytes);
+            UnitAlgebra bytes_ua(ua_buffer);
+            sim_output.output("\t  Rank 0 %4zuB pools: %s, %" PRIu64 " live, %.1f%% free\n",
+                              u.size, bytes_ua.toStringBestSI().c_str(), u.live,
+                              u.capacity == 0 ? 0.0 : 100.0 * (u.capacity - u.live) / u.capacity);
+        }
         sim_output.output("\tMax TimeVortex depth:            %" PRIu64 " entries\n",
                           global_max_tv_depth);
         sim_output.output("\tMax Sync data size:              %s\n",
@@ -0,0 +1,219 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+
+#include <sst/core/impl/timevortex/timeVortexHeap.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include <sst/core/output.h>
+#include <sst/core/simulation.h>
+
+namespace SST {
+namespace IMPL {
+
+TimeVortexHeap::TimeVortexHeap(Params& UNUSED(params)) :
+    TimeVortex(),
+    heap(NULL),
+    capacity(0),
+    insertOrder(0),
+    current_depth(0)
+{
+    max_depth = 0;
+    grow();
+}
+
+TimeVortexHeap::~TimeVortexHeap()
+{
+    // Activities in TimeVortexHeap all need to be deleted
+    for ( size_t i = 0; i < current_depth; i++ ) {
+        delete at(i).activity;
+    }
+    free(heap);
+}
+
+void TimeVortexHeap::grow()
+{
+    size_t new_capacity = capacity ? capacity * 2 : 1024;
+    void* mem = NULL;
+    if ( 0 != posix_memalign(&mem, arity * sizeof(Entry), (new_capacity + arity - 1) * sizeof(Entry)) ) {
+        Simulation::getSimulationOutput().fatal(CALL_INFO, 1, "TimeVortexHeap: unable to allocate space for %" PRIu64 " entries\n",
+                                                (uint64_t)new_capacity);
+    }
+    Entry* new_heap = static_cast<Entry*>(mem);
+    if ( heap != NULL ) {
+        memcpy(new_heap, heap, (capacity + arity - 1) * sizeof(Entry));
+        free(heap);
+    }
+    heap = new_heap;
+    capacity = new_capacity;
+}
+
+bool TimeVortexHeap::empty()
+{
+    return current_depth == 0;
+}
+
+int TimeVortexHeap::size()
+{
+    return current_depth;
+}
+
+inline TimeVortexHeap::Entry TimeVortexHeap::makeEntry(Activity* activity, uint64_t queue_order)
+{
+    // Flip the sign bits so that signed values order correctly as
+    // unsigned
+    Entry entry;
+    entry.time = activity->getDeliveryTime();
+    entry.order = (uint64_t)((uint32_t)activity->getPriority() ^ 0x80000000u) << 32;
+#ifdef SST_ENFORCE_EVENT_ORDERING
+    entry.order |= (uint32_t)activity->getEnforceLinkOrder() ^ 0x80000000u;
+#endif
+    entry.queue_order = queue_order;
+    entry.activity = activity;
+    return entry;
+}
+
+void TimeVortexHeap::push(Activity* activity, uint64_t queue_order)
+{
+    if ( current_depth == capacity ) grow();
+
+    Entry entry = makeEntry(activity, queue_order);
+
+    size_t hole = current_depth++;
+    while ( hole > 0 ) {
+        size_t parent = (hole - 1) / arity;
+        if ( !(entry < at(parent)) ) break;
+        at(hole) = at(parent);
+        hole = parent;
+    }
+    at(hole) = entry;
+}
+
+void TimeVortexHeap::removeTop()
+{
+    Entry entry = at(--current_depth);
+    siftDown(0, entry);
+}
+
+void TimeVortexHeap::siftDown(size_t hole, const Entry& entry)
+{
+    while ( true ) {
+        size_t child = hole * arity + 1;
+        if ( child >= current_depth ) break;
+        size_t end = child + arity;
+        if ( end > current_depth ) end = current_depth;
+        size_t best = child;
+        for ( ++child; child < end; ++child ) {
+            if ( at(child) < at(best) ) best = child;
+        }
+        if ( !(at(best) < entry) ) break;
+        at(hole) = at(best);
+        hole = best;
+    }
+    at(hole) = entry;
+}
+
+void TimeVortexHeap::insert(Activity* activity)
+{
+    activity->setQueueOrder(insertOrder);
+    checkBatch(activity);
+    push(activity, insertOrder++);
+
+    if ( current_depth > max_depth ) {
+        max_depth = current_depth;
+    }
+}
+
+void TimeVortexHeap::insertBatch(std::vector<Activity*>& activities)
+{
+    size_t count = activities.size();
+
+    // Pushing one at a time costs about log(n) per entry; rebuilding
+    // costs about n + count.  Rebuild when the batch is a sizable
+    // fraction of the heap.
+    if ( count * 4 < current_depth ) {
+        for ( size_t i = 0; i < count; i++ ) insert(activities[i]);
+        return;
+    }
+
+    while ( current_depth + count > capacity ) grow();
+    for ( size_t i = 0; i < count; i++ ) {
+        Activity* activity = activities[i];
+        activity->setQueueOrder(insertOrder);
+        checkBatch(activity);
+        at(current_depth++) = makeEntry(activity, insertOrder++);
+    }
+
+    // Bottom up rebuild, starting from the last node with children
+    if ( current_depth > 1 ) {
+        size_t node = (current_depth - 2) / arity + 1;
+        while ( node-- > 0 ) {
+            Entry entry = at(node);
+            siftDown(node, entry);
+        }
+    }
+
+    if ( current_depth > max_depth ) {
+        max_depth = current_depth;
+    }
+}
+
+Activity* TimeVortexHeap::pop()
+{
+    if ( current_depth == 0 ) return NULL;
+    Activity* ret_val = at(0).activity;
+    removeTop();
+    return ret_val;
+}
+
+Activity* TimeVortexHeap::front()
+{
+    if ( current_depth == 0 ) return NULL;
+    return at(0).activity;
+}
+
+void TimeVortexHeap::popBatch(std::vector<Activity*>& batch)
+{
+    if ( current_depth == 0 ) return;
+
+    // Batch membership is decided from the cached keys alone
+    SimTime_t time = at(0).time;
+    uint64_t priority = at(0).order >> 32;
+    startBatch(time, at(0).activity->getPriority());
+
+    do {
+        batch.push_back(at(0).activity);
+        removeTop();
+    } while ( current_depth != 0 && at(0).time == time && (at(0).order >> 32) == priority );
+}
+
+void TimeVortexHeap::requeue(Activity* activity)
+{
+    push(activity, activity->getQueueOrder());
+}
+
+void TimeVortexHeap::print(Output &out) const
+{
+    out.output("TimeVortex state:\n");
+
+    // Printed in heap order, not delivery order
+    for ( size_t i = 0; i < current_depth; i++ ) {
+        at(i).activity->print("  ", out);
+    }
+}
+
+
+} // namespace IMPL
+} // namespace SST
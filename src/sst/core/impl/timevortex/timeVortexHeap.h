@@ -0,0 +1,109 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXHEAP_H
+#define SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXHEAP_H
+
+#include <vector>
+
+#include <sst/core/timeVortex.h>
+#include <sst/core/elementinfo.h>
+
+namespace SST {
+
+class Output;
+
+namespace IMPL {
+
+
+/**
+ * Primary Event Queue implemented as a 4-ary heap that keeps a copy of
+ * each Activity's sort key next to the Activity pointer.  Sifting the
+ * heap only touches the heap array itself, never the Activities, and
+ * the children of a node share a single pair of cache lines.
+ *
+ * Ordering is the same as TimeVortexPQ.
+ */
+class TimeVortexHeap : public TimeVortex {
+
+public:
+    SST_ELI_REGISTER_DERIVED(
+        TimeVortex,
+        TimeVortexHeap,
+        "sst",
+        "timevortex.dary_heap",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "TimeVortex based on a 4-ary heap with sort keys stored inline.")
+
+
+public:
+    TimeVortexHeap(Params& params);
+    ~TimeVortexHeap();
+
+    bool empty() override;
+    int size() override;
+    void insert(Activity* activity) override;
+    void insertBatch(std::vector<Activity*>& activities) override;
+    Activity* pop() override;
+    Activity* front() override;
+    void popBatch(std::vector<Activity*>& batch) override;
+    void requeue(Activity* activity) override;
+
+    /** Print the state of the TimeVortex */
+    void print(Output &out) const override;
+
+    uint64_t getCurrentDepth() const override { return current_depth; }
+
+private:
+    static const size_t arity = 4;
+
+    struct Entry {
+        SimTime_t time;
+        uint64_t  order;        /*!< Priority in the upper half, link order in the lower half */
+        uint64_t  queue_order;
+        Activity* activity;
+
+        inline bool operator<(const Entry& rhs) const {
+            if ( time != rhs.time ) return time < rhs.time;
+            if ( order != rhs.order ) return order < rhs.order;
+            return queue_order < rhs.queue_order;
+        }
+    };
+
+    /** Entries are stored starting at index arity-1, so that the
+     * children of every node start on an aligned group of arity
+     * entries */
+    inline Entry& at(size_t index) { return heap[index + arity - 1]; }
+    inline const Entry& at(size_t index) const { return heap[index + arity - 1]; }
+
+    void grow();
+    /** Build the heap entry for an activity */
+    inline Entry makeEntry(Activity* activity, uint64_t queue_order);
+    /** Add an activity with the given queue order to the heap */
+    void push(Activity* activity, uint64_t queue_order);
+    /** Move entry down from hole until the heap is ordered again */
+    void siftDown(size_t hole, const Entry& entry);
+    /** Remove the root of the heap */
+    void removeTop();
+
+    Entry* heap;
+    size_t capacity;
+
+    uint64_t insertOrder;
+
+    uint64_t current_depth;
+
+};
+
+} // namespace IMPL
+} //namespace SST
+
+#endif // SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXHEAP_H
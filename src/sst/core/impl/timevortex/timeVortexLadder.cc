@@ -0,0 +1,257 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+
+#include <sst/core/impl/timevortex/timeVortexLadder.h>
+
+#include <algorithm>
+
+#include <sst/core/output.h>
+
+namespace SST {
+namespace IMPL {
+
+TimeVortexLadder::TimeVortexLadder(Params& params) :
+    TimeVortex(),
+    top_last(0),
+    nrungs(0),
+    insertOrder(0),
+    current_depth(0)
+{
+    max_depth = 0;
+    bucket_threshold = params.find<size_t>("bucket_threshold", 50);
+    max_rungs = params.find<size_t>("max_rungs", 8);
+    max_buckets = params.find<size_t>("max_buckets", 65536);
+
+    if ( max_rungs < 1 ) max_rungs = 1;
+    if ( max_buckets < 1 ) max_buckets = 1;
+    rungs.resize(max_rungs);
+}
+
+TimeVortexLadder::~TimeVortexLadder()
+{
+    // Activities in TimeVortexLadder all need to be deleted
+    for ( auto act : bottom ) delete act;
+    for ( size_t i = 0; i < nrungs; i++ ) {
+        for ( auto& bucket : rungs[i].buckets ) {
+            for ( auto act : bucket ) delete act;
+        }
+    }
+    for ( auto act : top ) delete act;
+}
+
+bool TimeVortexLadder::empty()
+{
+    return current_depth == 0;
+}
+
+int TimeVortexLadder::size()
+{
+    return current_depth;
+}
+
+void TimeVortexLadder::getTimeRange(const bucket_t& src, SimTime_t& min, SimTime_t& max)
+{
+    min = MAX_SIMTIME_T;
+    max = 0;
+    for ( auto act : src ) {
+        SimTime_t time = act->getDeliveryTime();
+        if ( time < min ) min = time;
+        if ( time > max ) max = time;
+    }
+}
+
+void TimeVortexLadder::spawnRung(bucket_t& src, SimTime_t min, SimTime_t max)
+{
+    Rung& rung = rungs[nrungs++];
+
+    // Aim for about one activity per bucket.  Computing the width
+    // this way can't overflow, even when max is MAX_SIMTIME_T.
+    SimTime_t span = max - min;
+    size_t nb = std::min(src.size(), max_buckets);
+    rung.start = min;
+    rung.width = span / nb + 1;
+    rung.nbuckets = span / rung.width + 1;
+    rung.cur = 0;
+    rung.count = src.size();
+    // Buckets left over from a previous use of this rung are empty
+    if ( rung.buckets.size() < rung.nbuckets ) rung.buckets.resize(rung.nbuckets);
+
+    for ( auto act : src ) {
+        rung.buckets[(act->getDeliveryTime() - min) / rung.width].push_back(act);
+    }
+    src.clear();
+}
+
+void TimeVortexLadder::refillBottom()
+{
+    while ( bottom.empty() ) {
+        SimTime_t min, max;
+        if ( nrungs == 0 ) {
+            if ( top.empty() ) return;
+
+            // Everything later than what is in the top list now will
+            // go back into the top list
+            getTimeRange(top, min, max);
+            top_last = max;
+            if ( min == max ) {
+                bottom.swap(top);
+                break;
+            }
+            spawnRung(top, min, max);
+        }
+
+        // Pull the next non-empty bucket out of the innermost rung
+        Rung& rung = rungs[nrungs - 1];
+        while ( rung.buckets[rung.cur].empty() ) rung.cur++;
+        scratch.swap(rung.buckets[rung.cur]);
+        rung.cur++;
+        rung.count -= scratch.size();
+        // Drop the rung once it is exhausted so that curStart() of
+        // the remaining rungs always names a real bucket
+        if ( rung.count == 0 ) nrungs--;
+
+        if ( scratch.size() > bucket_threshold && nrungs < max_rungs ) {
+            getTimeRange(scratch, min, max);
+            if ( min != max ) {
+                spawnRung(scratch, min, max);
+                continue;
+            }
+        }
+        bottom.swap(scratch);
+    }
+    std::sort(bottom.begin(), bottom.end(), compare);
+}
+
+void TimeVortexLadder::insert(Activity* activity)
+{
+    activity->setQueueOrder(insertOrder++);
+    checkBatch(activity);
+    current_depth++;
+    if ( current_depth > max_depth ) {
+        max_depth = current_depth;
+    }
+    place(activity);
+}
+
+void TimeVortexLadder::place(Activity* activity)
+{
+    SimTime_t time = activity->getDeliveryTime();
+    if ( time > top_last || (nrungs == 0 && bottom.empty()) ) {
+        top.push_back(activity);
+        return;
+    }
+
+    for ( size_t i = 0; i < nrungs; i++ ) {
+        Rung& rung = rungs[i];
+        if ( time >= rung.curStart() ) {
+            // Activities past the end of an inner rung still belong
+            // before the next bucket of the rung above it, so they
+            // go into the last bucket
+            size_t index = std::min((time - rung.start) / rung.width, rung.nbuckets - 1);
+            rung.buckets[index].push_back(activity);
+            rung.count++;
+            return;
+        }
+    }
+
+    // Activity falls in the range currently being dequeued.  If the
+    // bottom list has grown too large to keep sorted cheaply, spread
+    // it into a new rung first.
+    if ( bottom.size() >= bucket_threshold && nrungs < max_rungs ) {
+        SimTime_t min = bottom.back()->getDeliveryTime();
+        SimTime_t max = bottom.front()->getDeliveryTime();
+        if ( min != max ) {
+            spawnRung(bottom, min, max);
+            Rung& rung = rungs[nrungs - 1];
+            if ( time >= rung.start ) {
+                size_t index = std::min((time - rung.start) / rung.width, rung.nbuckets - 1);
+                rung.buckets[index].push_back(activity);
+                rung.count++;
+                return;
+            }
+        }
+    }
+
+    bottom.insert(std::upper_bound(bottom.begin(), bottom.end(), activity, compare), activity);
+}
+
+Activity* TimeVortexLadder::pop()
+{
+    if ( bottom.empty() ) refillBottom();
+    if ( bottom.empty() ) return NULL;
+    Activity* ret_val = bottom.back();
+    bottom.pop_back();
+    current_depth--;
+    return ret_val;
+}
+
+Activity* TimeVortexLadder::front()
+{
+    if ( bottom.empty() ) refillBottom();
+    if ( bottom.empty() ) return NULL;
+    return bottom.back();
+}
+
+void TimeVortexLadder::popBatch(std::vector<Activity*>& batch)
+{
+    if ( bottom.empty() ) refillBottom();
+    if ( bottom.empty() ) return;
+
+    // Activities never share a delivery time with anything outside of
+    // the bottom list, so the whole batch is at the back of it
+    Activity* act = bottom.back();
+    SimTime_t time = act->getDeliveryTime();
+    int priority = act->getPriority();
+    startBatch(time, priority);
+
+    do {
+        batch.push_back(act);
+        bottom.pop_back();
+        current_depth--;
+        if ( bottom.empty() ) break;
+        act = bottom.back();
+    } while ( act->getDeliveryTime() == time && act->getPriority() == priority );
+}
+
+void TimeVortexLadder::requeue(Activity* activity)
+{
+    current_depth++;
+    place(activity);
+}
+
+void TimeVortexLadder::print(Output &out) const
+{
+    out.output("TimeVortex state:\n");
+
+    // Only the bottom list is in order; rungs and top are printed
+    // in bucket order
+    for ( auto it = bottom.rbegin(); it != bottom.rend(); ++it ) {
+        (*it)->print("  ", out);
+    }
+    for ( size_t i = nrungs; i > 0; i-- ) {
+        const Rung& rung = rungs[i - 1];
+        for ( size_t j = rung.cur; j < rung.nbuckets; j++ ) {
+            for ( auto act : rung.buckets[j] ) {
+                act->print("  ", out);
+            }
+        }
+    }
+    for ( auto act : top ) {
+        act->print("  ", out);
+    }
+}
+
+
+} // namespace IMPL
+} // namespace SST
@@ -0,0 +1,129 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXLADDER_H
+#define SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXLADDER_H
+
+#include <vector>
+
+#include <sst/core/timeVortex.h>
+#include <sst/core/elementinfo.h>
+
+namespace SST {
+
+class Output;
+
+namespace IMPL {
+
+
+/**
+ * Primary Event Queue implemented as a Ladder Queue (Tang, Goh and
+ * Thng, "Ladder Queue: An O(1) Priority Queue Structure for
+ * Large-Scale Discrete Event Simulation").
+ *
+ * Activities are first appended, unsorted, to the top list.  When
+ * the sorted bottom list runs dry, the top list is spread by
+ * delivery time into the buckets of a rung.  Buckets that are still
+ * too full are recursively spread into finer rungs, and the first
+ * small enough bucket is sorted into the bottom list, which is what
+ * pop() and front() are served from.  Sorting uses the same
+ * comparator as TimeVortexPQ, so activities come out in exactly the
+ * same order.
+ */
+class TimeVortexLadder : public TimeVortex {
+
+public:
+    SST_ELI_REGISTER_DERIVED(
+        TimeVortex,
+        TimeVortexLadder,
+        "sst",
+        "timevortex.ladder_queue",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "TimeVortex based on a ladder queue with O(1) amortized insert and pop.")
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"bucket_threshold", "Largest bucket that is sorted directly into the bottom list instead of being spread into a new rung", "50"},
+        {"max_rungs",        "Maximum number of rungs in the ladder", "8"},
+        {"max_buckets",      "Maximum number of buckets in a single rung", "65536"}
+    )
+
+public:
+    TimeVortexLadder(Params& params);
+    ~TimeVortexLadder();
+
+    bool empty() override;
+    int size() override;
+    void insert(Activity* activity) override;
+    Activity* pop() override;
+    Activity* front() override;
+    void popBatch(std::vector<Activity*>& batch) override;
+    void requeue(Activity* activity) override;
+
+    /** Print the state of the TimeVortex */
+    void print(Output &out) const override;
+
+    uint64_t getCurrentDepth() const override { return current_depth; }
+
+private:
+#ifdef SST_ENFORCE_EVENT_ORDERING
+    typedef Activity::pq_less_time_priority_order compare_t;
+#else
+    typedef Activity::pq_less_time_priority compare_t;
+#endif
+    typedef std::vector<Activity*> bucket_t;
+
+    /** One level of the ladder.  Bucket i holds the activities with
+     * delivery times in [start + i*width, start + (i+1)*width). */
+    struct Rung {
+        std::vector<bucket_t> buckets;
+        SimTime_t start;
+        SimTime_t width;
+        size_t    nbuckets;
+        size_t    cur;      /*!< Next bucket to be dequeued */
+        size_t    count;    /*!< Activities left in this rung */
+
+        /** First delivery time that still belongs to this rung */
+        SimTime_t curStart() const { return start + cur * width; }
+    };
+
+    /** Find the earliest and latest delivery times in a bucket */
+    static void getTimeRange(const bucket_t& src, SimTime_t& min, SimTime_t& max);
+    /** Spread the activities in src, which span [min, max], into a
+     * new innermost rung.  src is left empty. */
+    void spawnRung(bucket_t& src, SimTime_t min, SimTime_t max);
+    /** Move the next bucket into the bottom list, creating rungs as
+     * necessary.  Only called when bottom is empty. */
+    void refillBottom();
+    /** Put an activity in the top list, a rung or the bottom list */
+    void place(Activity* activity);
+
+    bucket_t top;
+    SimTime_t top_last;       /*!< Last delivery time covered by the rungs and bottom */
+    std::vector<Rung> rungs;  /*!< Rung objects are reused to keep bucket storage */
+    size_t nrungs;
+    bucket_t bottom;          /*!< Sorted so that the next activity is at the back */
+    bucket_t scratch;
+
+    compare_t compare;
+    size_t bucket_threshold;
+    size_t max_rungs;
+    size_t max_buckets;
+
+    uint64_t insertOrder;
+
+    uint64_t current_depth;
+
+};
+
+} // namespace IMPL
+} //namespace SST
+
+#endif // SST_CORE_IMPL_TIMEVORTEX_TIMEVORTEXLADDER_H
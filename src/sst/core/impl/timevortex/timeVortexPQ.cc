@@ -52,6 +52,7 @@ int TimeVortexPQ::size()
 void TimeVortexPQ::insert(Activity* activity)
 {
     activity->setQueueOrder(insertOrder++);
+    checkBatch(activity);
     data.push(activity);
     current_depth++;
     if ( current_depth > max_depth ) {
@@ -74,6 +75,28 @@ Activity* TimeVortexPQ::front()
     return data.top();
 }
 
+void TimeVortexPQ::popBatch(std::vector<Activity*>& batch)
+{
+    Activity* act = data.top();
+    SimTime_t time = act->getDeliveryTime();
+    int priority = act->getPriority();
+    startBatch(time, priority);
+
+    do {
+        batch.push_back(act);
+        data.pop();
+        current_depth--;
+        if ( data.empty() ) break;
+        act = data.top();
+    } while ( act->getDeliveryTime() == time && act->getPriority() == priority );
+}
+
+void TimeVortexPQ::requeue(Activity* activity)
+{
+    data.push(activity);
+    current_depth++;
+}
+
 void TimeVortexPQ::print(Output &out) const
 {
     out.output("TimeVortex state:\n");
@@ -51,6 +51,8 @@ public:
     void insert(Activity* activity) override;
     Activity* pop() override;
     Activity* front() override;
+    void popBatch(std::vector<Activity*>& batch) override;
+    void requeue(Activity* activity) override;
 
     /** Print the state of the TimeVortex */
     void print(Output &out) const override;
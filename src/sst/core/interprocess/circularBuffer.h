@@ -94,6 +94,23 @@ public:
 		}
 	}
 
+	bool writeNB(const T& v) {
+		if( bufferMutex.try_lock() ) {
+			if( ((writeIndex + 1) % buffSize) != readIndex ) {
+				buffer[writeIndex] = v;
+				writeIndex = (writeIndex + 1) % buffSize;
+
+				__sync_synchronize();
+				bufferMutex.unlock();
+				return true;
+			}
+
+			bufferMutex.unlock();
+		}
+
+		return false;
+	}
+
 	~CircularBuffer() {
 
 	}
@@ -211,6 +211,11 @@ public:
         circBuffs[core]->write(command);
     }
 
+    /** Non-blocking version of writeMessage **/
+    bool writeMessageNB(size_t core, const MsgType &command) {
+        return circBuffs[core]->writeNB(command);
+    }
+
     /** Blocks until a command is available **/
     MsgType readMessage(size_t buffer) {
         return circBuffs[buffer]->read();
@@ -0,0 +1,189 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/interprocess/rankTunnel.h>
+
+#include <algorithm>
+#include <csignal>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+namespace SST {
+namespace Core {
+namespace Interprocess {
+
+RankTunnel* RankTunnel::instance = NULL;
+
+RankTunnel::RankTunnel(uint32_t num_ranks) :
+    rank(0),
+    num_ranks(num_ranks),
+    parity(0)
+{
+    tunnel = new IPCTunnel<RankTunnelShared, RankTunnelChunk>(0, num_ranks * num_ranks, ring_chunks, 0);
+    // Nothing attaches by name, so the region can go once it is mapped
+    shm_unlink(tunnel->getRegionName().c_str());
+}
+
+RankTunnel::~RankTunnel()
+{
+    delete tunnel;
+}
+
+int
+RankTunnel::launch(uint32_t num_ranks, int& status)
+{
+    status = 0;
+    if ( num_ranks > RankTunnelShared::max_ranks ) {
+        fprintf(stderr, "At most %d ranks can share a RankTunnel\n", (int)RankTunnelShared::max_ranks);
+        status = 1;
+        return -1;
+    }
+
+    instance = new RankTunnel(num_ranks);
+
+    // Anything still buffered would be written once by every child
+    fflush(stdout);
+    fflush(stderr);
+
+    std::vector<pid_t> children;
+    for ( uint32_t i = 0; i < num_ranks; i++ ) {
+        pid_t pid = fork();
+        if ( pid == 0 ) {
+            instance->rank = i;
+            return i;
+        }
+        if ( pid < 0 ) {
+            fprintf(stderr, "Failed to fork rank %" PRIu32 ": %s\n", i, strerror(errno));
+            status = 1;
+            for ( pid_t child : children ) kill(child, SIGKILL);
+            break;
+        }
+        children.push_back(pid);
+    }
+
+    while ( !children.empty() ) {
+        int wstatus;
+        pid_t pid = waitpid(-1, &wstatus, 0);
+        if ( pid < 0 ) {
+            if ( errno == EINTR ) continue;
+            break;
+        }
+        std::vector<pid_t>::iterator child = std::find(children.begin(), children.end(), pid);
+        if ( child == children.end() ) continue;
+        children.erase(child);
+
+        int code = WIFEXITED(wstatus) ? WEXITSTATUS(wstatus) : 128 + WTERMSIG(wstatus);
+        if ( code != 0 && status == 0 ) {
+            status = code;
+            // The other ranks would wait for this one forever
+            for ( pid_t other : children ) kill(other, SIGKILL);
+        }
+    }
+
+    delete instance;
+    instance = NULL;
+    return -1;
+}
+
+void
+RankTunnel::barrier()
+{
+    RankTunnelShared* shared = tunnel->getSharedData();
+    // The generation cannot move until this rank has arrived
+    uint32_t generation = shared->generation;
+    __sync_synchronize();
+    if ( __sync_add_and_fetch(&shared->arrived, 1) == num_ranks ) {
+        shared->arrived = 0;
+        __sync_synchronize();
+        shared->generation = generation + 1;
+    }
+    else {
+        int loop_counter = 0;
+        while ( shared->generation == generation ) {
+            pause.processorPause(loop_counter++);
+        }
+    }
+    __sync_synchronize();
+}
+
+void
+RankTunnel::exchange(const std::vector<int>& peers,
+                     const std::vector<std::pair<const char*, size_t> >& sends,
+                     std::vector<std::vector<char> >& recvs)
+{
+    size_t count = peers.size();
+    std::vector<size_t> sent(count, 0);
+    std::vector<bool> send_done(count, false);
+    std::vector<bool> recv_done(count, false);
+    recvs.resize(count);
+    for ( size_t i = 0; i < count; i++ ) recvs[i].clear();
+
+    // Each peer's data is written while it fits and read as it
+    // arrives, so two ranks sending each other more than a buffer
+    // holds both make progress
+    size_t remaining = 2 * count;
+    RankTunnelChunk chunk;
+    int loop_counter = 0;
+    while ( remaining > 0 ) {
+        bool progress = false;
+        for ( size_t i = 0; i < count; i++ ) {
+            while ( !send_done[i] ) {
+                size_t size = std::min(sends[i].second - sent[i], (size_t)RankTunnelChunk::payload);
+                chunk.size = size;
+                chunk.last = ( sent[i] + size == sends[i].second );
+                ::memcpy(chunk.data, sends[i].first + sent[i], size);
+                if ( !tunnel->writeMessageNB(ring(rank, peers[i]), chunk) ) break;
+                sent[i] += size;
+                progress = true;
+                if ( chunk.last ) {
+                    send_done[i] = true;
+                    remaining--;
+                }
+            }
+            while ( !recv_done[i] && tunnel->readMessageNB(ring(peers[i], rank), &chunk) ) {
+                recvs[i].insert(recvs[i].end(), chunk.data, chunk.data + chunk.size);
+                progress = true;
+                if ( chunk.last ) {
+                    recv_done[i] = true;
+                    remaining--;
+                }
+            }
+        }
+        if ( progress ) loop_counter = 0;
+        else pause.processorPause(loop_counter++);
+    }
+}
+
+void
+RankTunnel::allgather(const std::vector<char>& data, std::vector<std::vector<char> >& out)
+{
+    std::vector<int> peers;
+    std::vector<std::pair<const char*, size_t> > sends;
+    for ( uint32_t i = 0; i < num_ranks; i++ ) {
+        if ( i == rank ) continue;
+        peers.push_back(i);
+        sends.push_back(std::make_pair(data.data(), data.size()));
+    }
+
+    std::vector<std::vector<char> > recvs;
+    exchange(peers, sends, recvs);
+
+    out.resize(num_ranks);
+    out[rank] = data;
+    for ( size_t i = 0; i < peers.size(); i++ ) {
+        out[peers[i]].swap(recvs[i]);
+    }
+}
+
+}
+}
+}
@@ -0,0 +1,140 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_INTERPROCESS_RANKTUNNEL_H
+#define SST_CORE_INTERPROCESS_RANKTUNNEL_H 1
+
+#include <inttypes.h>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <sst/core/interprocess/ipctunnel.h>
+#include <sst/core/interprocess/sstmutex.h>
+
+namespace SST {
+namespace Core {
+namespace Interprocess {
+
+/**
+ * Piece of a message between two ranks of a RankTunnel
+ */
+struct RankTunnelChunk {
+    enum { payload = 4096 - 2 * sizeof(uint32_t) };
+    /** Bytes of data used */
+    uint32_t size;
+    /** Set on the last chunk of a message */
+    uint32_t last;
+    char data[payload];
+};
+
+/**
+ * Region shared by all the ranks of a RankTunnel
+ */
+struct RankTunnelShared {
+    enum { max_ranks = 256 };
+    /** Ranks waiting in the barrier */
+    volatile uint32_t arrived;
+    /** Bumped by the last rank into the barrier to release the rest */
+    volatile uint32_t generation;
+    /** Each rank's contribution to a reduction.  Reductions alternate
+     * between the two sets, so a rank can start the next one while
+     * others are still reading the last. */
+    uint64_t slots[2][max_ranks];
+};
+
+/**
+ * Connects the ranks of a simulation run as processes on one node,
+ * without MPI (--ipc-ranks).  The tunnel is created before the ranks
+ * are forked, so each one inherits the mapping.  There is a circular
+ * buffer for each ordered pair of ranks, and the shared region holds
+ * a barrier and the slots used for reductions.
+ */
+class RankTunnel {
+public:
+    enum ReduceOp { MIN, MAX, SUM };
+
+    /** Circular buffer entries for each pair of ranks */
+    enum { ring_chunks = 16 };
+
+    /**
+     * Create the tunnel and fork num_ranks processes to use it.
+     * Returns each child's rank in the child.  The calling process
+     * waits for all of them and returns -1, with status set to the
+     * exit code of the first rank to fail, or 0.  If a rank fails,
+     * the others are killed, since they would wait for it forever.
+     */
+    static int launch(uint32_t num_ranks, int& status);
+
+    /** The tunnel of this process, or NULL when not run with --ipc-ranks */
+    static RankTunnel* get() { return instance; }
+
+    uint32_t getRank() const { return rank; }
+    uint32_t getNumRanks() const { return num_ranks; }
+
+    /** Wait for every rank */
+    void barrier();
+
+    /** Combine value across every rank */
+    template <typename T>
+    T allreduce(T value, ReduceOp op)
+    {
+        static_assert(sizeof(T) <= sizeof(uint64_t), "RankTunnel reductions hold at most 64 bits per rank");
+        uint64_t* slots = tunnel->getSharedData()->slots[parity];
+        parity ^= 1;
+        ::memcpy(&slots[rank], &value, sizeof(T));
+        barrier();
+
+        T result;
+        ::memcpy(&result, &slots[0], sizeof(T));
+        for ( uint32_t i = 1; i < num_ranks; i++ ) {
+            T other;
+            ::memcpy(&other, &slots[i], sizeof(T));
+            switch ( op ) {
+            case MIN: if ( other < result ) result = other; break;
+            case MAX: if ( other > result ) result = other; break;
+            case SUM: result += other; break;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Send sends[i] to peers[i] and receive recvs[i] from it, for all
+     * the peers at once.  Every peer must make the matching call.
+     */
+    void exchange(const std::vector<int>& peers,
+                  const std::vector<std::pair<const char*, size_t> >& sends,
+                  std::vector<std::vector<char> >& recvs);
+
+    /** Send data to every other rank and receive theirs, indexed by rank */
+    void allgather(const std::vector<char>& data, std::vector<std::vector<char> >& out);
+
+private:
+    RankTunnel(uint32_t num_ranks);
+    ~RankTunnel();
+
+    size_t ring(uint32_t from, uint32_t to) const { return from * num_ranks + to; }
+
+    static RankTunnel* instance;
+
+    IPCTunnel<RankTunnelShared, RankTunnelChunk>* tunnel;
+    uint32_t rank;
+    uint32_t num_ranks;
+    int parity;
+    SSTMutex pause;
+};
+
+}
+}
+}
+
+#endif
@@ -16,11 +16,7 @@
 
 #include <sys/resource.h>
 #include <sst/core/warnmacros.h>
-#ifdef SST_CONFIG_HAVE_MPI
-DISABLE_WARN_MISSING_OVERRIDE
-#include <mpi.h>
-REENABLE_WARNING
-#endif
+#include <sst/core/objectComms.h>
 
 
 using namespace SST::Core;
@@ -30,11 +26,7 @@ uint64_t SST::Core::maxInputOperations() {
     getrusage(RUSAGE_SELF, &sim_ruse);
 
     uint64_t local_max_io_in = sim_ruse.ru_inblock;
-    uint64_t global_max_io_in = local_max_io_in;
-
-#ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_max_io_in, &global_max_io_in, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-#endif
+    uint64_t global_max_io_in = Comms::all_reduce(local_max_io_in, Comms::REDUCE_MAX);
 
     return global_max_io_in;
 }
@@ -44,11 +36,7 @@ uint64_t SST::Core::maxOutputOperations() {
     getrusage(RUSAGE_SELF, &sim_ruse);
 
     uint64_t local_max_io_out = sim_ruse.ru_oublock;
-    uint64_t global_max_io_out = local_max_io_out;
-
-#ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_max_io_out, &global_max_io_out, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-#endif
+    uint64_t global_max_io_out = Comms::all_reduce(local_max_io_out, Comms::REDUCE_MAX);
 
     return global_max_io_out;
 }
@@ -222,6 +222,7 @@ void finalize_statEngineConfig(void)
 static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSafe::Barrier &barrier)
 {
     info.myRank.thread = tid;
+    Core::ThreadSafe::Barrier::setThreadIndex(tid);
     double start_build = sst_get_cpu_time();
 
     if ( tid ) {
@@ -649,7 +650,15 @@ main(int argc, char *argv[])
 
 
     ////// Create Simulation //////
+    // Spinning only pays off when every thread has a core to itself
+    if ( cfg.barrier_spin == "auto" ) {
+        unsigned cores = std::thread::hardware_concurrency();
+        Core::ThreadSafe::Barrier::setSpinBudget(( cores != 0 && world_size.thread > cores ) ? 0 : 1024);
+    } else {
+        Core::ThreadSafe::Barrier::setSpinBudget(strtoul(cfg.barrier_spin.c_str(), NULL, 0));
+    }
     Core::ThreadSafe::Barrier mainBarrier(world_size.thread);
+    mainBarrier.setName("main");
 
     Simulation::factory = factory;
     Simulation::sim_output = g_output;
@@ -657,6 +666,11 @@ main(int argc, char *argv[])
     #ifdef USE_MEMPOOL
     /* Estimate that we won't have more than 128 sizes of events */
     Activity::memPools.reserve(world_size.thread * 128);
+    if ( cfg.mempool_hugepages == "transparent" ) {
+        Core::MemPool::setHugePageMode(Core::MemPool::HUGEPAGE_TRANSPARENT);
+    } else if ( cfg.mempool_hugepages == "explicit" ) {
+        Core::MemPool::setHugePageMode(Core::MemPool::HUGEPAGE_EXPLICIT);
+    }
     #endif
 
     std::vector<std::thread> threads(world_size.thread);
@@ -808,6 +822,15 @@ main(int argc, char *argv[])
                 global_max_sync_data_size_ua.toStringBestSI().c_str());
         g_output.output( "Global Sync data size:           %s\n",
                 global_sync_data_size_ua.toStringBestSI().c_str());
+#ifdef __SST_ENABLE_PROFILE__
+        g_output.output( "\n");
+        g_output.output( "Rank 0 Barrier Wait Time (summed over threads):\n");
+        for ( auto b : Core::ThreadSafe::Barrier::getNamedBarriers() ) {
+            if ( b->getWaitCount() == 0 ) continue;
+            g_output.output( "  %-31s %f seconds, %" PRIu64 " waits\n",
+                    (b->getName() + ":").c_str(), b->getWaitTime(), b->getWaitCount());
+        }
+#endif
         g_output.output( "------------------------------------------------------------\n");
         g_output.output( "\n" );
         g_output.output( "\n" );
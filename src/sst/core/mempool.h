@@ -12,8 +12,10 @@
 #ifndef SST_CORE_MEMPOOL_H
 #define SST_CORE_MEMPOOL_H
 
+#include <algorithm>
 #include <list>
 #include <deque>
+#include <vector>
 
 #include <cstddef>
 #include <cstdlib>
@@ -29,6 +31,19 @@ namespace Core {
 
 /**
  * Simple Memory Pool class
+ *
+ * Each pool belongs to a single thread, which is the only thread
+ * allowed to allocate from it.  The owner allocates from and frees to
+ * a private cache without any locking, and only goes to the shared
+ * free list in bulk.  Other threads push the elements they free onto
+ * a lock-free return queue, which the owner drains in one go when its
+ * cache runs dry or at a sync point.  Elements must be large enough to
+ * hold two pointers.
+ *
+ * Arenas are aligned to their size and keep a count of their live
+ * elements in a header in the first element slot.  When the pool has
+ * far more free elements than live ones, arenas that no longer hold
+ * any live element are returned to the OS.
  */
 class MemPool
 {
@@ -42,6 +57,11 @@ class MemPool
             list.push_back(ptr);
         }
 
+        inline void insert(void **ptrs, size_t count) {
+            std::lock_guard<LOCK_t> lock(mtx);
+            list.insert(list.end(), ptrs, ptrs + count);
+        }
+
         inline void* try_remove() {
             std::lock_guard<LOCK_t> lock(mtx);
             if ( list.empty() ) return NULL;
@@ -50,86 +70,283 @@ class MemPool
             return p;
         }
 
+        /** Move up to count elements to the back of dst */
+        inline size_t try_remove(std::vector<void*>& dst, size_t count) {
+            std::lock_guard<LOCK_t> lock(mtx);
+            if ( count > list.size() ) count = list.size();
+            dst.insert(dst.end(), list.end() - count, list.end());
+            list.resize(list.size() - count);
+            return count;
+        }
+
         size_t size() const { return list.size(); }
     };
 
 
 public:
+    /** How arenas are backed by huge pages */
+    enum HugePageMode {
+        HUGEPAGE_NONE,          /*!< Regular pages */
+        HUGEPAGE_TRANSPARENT,   /*!< Huge page aligned and madvise()'d for transparent huge pages */
+        HUGEPAGE_EXPLICIT       /*!< MAP_HUGETLB, falling back to transparent huge pages */
+    };
+
+    /** Set the huge page mode used for all arenas allocated from now on */
+    static void setHugePageMode(HugePageMode mode) { hugePageMode() = mode; }
+    static HugePageMode getHugePageMode() { return hugePageMode(); }
+
+    /** Number of elements moved between the cache and the free list at once */
+    static const size_t cacheBatch = 256;
+    /** Size of the cache at which elements are returned to the free list */
+    static const size_t cacheLimit = 4 * cacheBatch;
+
     /** Create a new Memory Pool.
      * @param elementSize - Size of each Element
-     * @param initialSize - Size of the memory pool (in bytes)
+     * @param initialSize - Size of each arena (in bytes), rounded up to a power of two
+     * @param owner - Token identifying the thread that owns the pool
      */
-	MemPool(size_t elementSize, size_t initialSize=(2<<20)) :
-        numAlloc(0), numFree(0),
-        elemSize(elementSize), arenaSize(initialSize),
-        allocating(false)
+	MemPool(size_t elementSize, size_t initialSize=(2<<20), const void* owner=NULL) :
+        numAlloc(0), numLocalFree(0),
+        elemSize(elementSize), arenaSize(1), owner(owner),
+        allocating(false), numArenas(0), emptyArenas(0), bytesReclaimed(0),
+        remoteHead(NULL), numRemoteFree(0)
     {
+        while ( arenaSize < initialSize ) arenaSize <<= 1;
+        cache.reserve(cacheLimit + 1);
         allocPool();
     }
 
 	~MemPool()
     {
-        for ( std::list<uint8_t*>::iterator i = arenas.begin() ; i != arenas.end() ; ++i ) {
-            ::free(*i);
+        for ( std::vector<uint8_t*>::iterator i = arenas.begin() ; i != arenas.end() ; ++i ) {
+            ::munmap(*i, arenaSize);
         }
     }
 
-    /** Allocate a new element from the memory pool */
+    /** Allocate a new element from the memory pool.  May only be
+     * called by the owning thread. */
 	inline void* malloc()
     {
-        void *ret = freeList.try_remove();
-        while ( !ret ) {
-            bool ok = allocPool();
-            if ( !ok ) return NULL;
-#if ( defined( __amd64 ) || defined( __amd64__ ) || \
-        defined( __x86_64 ) || defined( __x86_64__ ) )
-            _mm_pause();
-#elif defined(__PPC64__)
-       	    asm volatile( "or 27, 27, 27" ::: "memory" );
-#endif
-            ret = freeList.try_remove();
-        }
-        ++numAlloc;
+        if ( cache.empty() && !refill() ) return NULL;
+        void *ret = cache.back();
+        cache.pop_back();
+        if ( 0 == arenaOf(ret)->live++ ) --emptyArenas;
+        // Only the owner updates numAlloc, so no atomic add is needed
+        numAlloc.store(numAlloc.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
         return ret;
     }
 
-    /** Return an element to the memory pool */
+    /** Return an element to the memory pool from a thread other than
+     * the owner. */
 	inline void free(void *ptr)
     {
         // TODO:  Make sure this is in one of our arenas
-        freeList.insert(ptr);
-// #ifdef __SST_DEBUG_EVENT_TRACKING__
-//         *((uint64_t*)ptr) = 0xFFFFFFFFFFFFFFFF;
-// #endif
-        ++numFree;
+        // The link lives in the second word, so that the first word
+        // stays NULL for printUndeletedActivities()
+        void** link = (void**)ptr + 1;
+        void* head = remoteHead.load(std::memory_order_relaxed);
+        do {
+            *link = head;
+        } while ( !remoteHead.compare_exchange_weak(head, ptr, std::memory_order_release, std::memory_order_relaxed) );
+        numRemoteFree.fetch_add(1, std::memory_order_relaxed);
     }
 
+    /** Return an element to the owning thread's cache.  May only be
+     * called by the owning thread. */
+    inline void localFree(void *ptr)
+    {
+        cache.push_back(ptr);
+        numLocalFree.store(numLocalFree.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        bool emptied = ( 0 == --arenaOf(ptr)->live );
+        if ( emptied ) ++emptyArenas;
+        if ( cache.size() > cacheLimit ) {
+            freeList.insert(&cache[cache.size() - cacheBatch], cacheBatch);
+            cache.resize(cache.size() - cacheBatch);
+        }
+        if ( emptied ) maybeReclaim();
+    }
+
+    /** Move elements freed by other threads into the owner's cache.
+     * May only be called by the owning thread.
+     * @return number of elements reclaimed
+     */
+    size_t drainRemoteFrees()
+    {
+        size_t count = takeRemoteFrees();
+        if ( cache.size() > cacheLimit ) spillCache();
+        if ( count != 0 ) maybeReclaim();
+        return count;
+    }
+
+    /** Unmap every arena (but one) that has no live elements.  May
+     * only be called by the owning thread.
+     * @return number of bytes returned to the OS
+     */
+    uint64_t reclaim()
+    {
+        takeRemoteFrees();
+        if ( emptyArenas == 0 || arenas.size() <= 1 ) return 0;
+
+        // Flag the arenas to release, then drop their elements from the
+        // free lists before unmapping them
+        size_t nrelease = 0;
+        for ( uint8_t* arena : arenas ) {
+            ArenaHeader* header = (ArenaHeader*)arena;
+            if ( header->live == 0 && nrelease + 1 < arenas.size() ) {
+                header->live = releasedArena;
+                ++nrelease;
+            }
+        }
+        freeList.try_remove(cache, freeList.size());
+        cache.erase(std::remove_if(cache.begin(), cache.end(),
+                                   [this](void* ptr) { return arenaOf(ptr)->live == releasedArena; }),
+                    cache.end());
+        size_t j = 0;
+        for ( size_t i = 0 ; i < arenas.size() ; i++ ) {
+            if ( ((ArenaHeader*)arenas[i])->live == releasedArena ) ::munmap(arenas[i], arenaSize);
+            else arenas[j++] = arenas[i];
+        }
+        arenas.resize(j);
+        emptyArenas -= nrelease;
+        numArenas.store(arenas.size(), std::memory_order_relaxed);
+        bytesReclaimed.fetch_add(nrelease * arenaSize, std::memory_order_relaxed);
+        spillCache();
+        return nrelease * arenaSize;
+    }
+
+    /** Returns true if the calling thread is the owner identified by token */
+    bool isOwner(const void* token) const { return owner == token; }
+
     /**
        Approximates the current memory usage of the mempool. Some
        overheads are not taken into account.
      */
     uint64_t getBytesMemUsed() {
-        uint64_t bytes_in_arenas = arenas.size() * arenaSize;
-        uint64_t bytes_in_free_list = freeList.size() * sizeof(void*);
+        uint64_t bytes_in_arenas = numArenas.load(std::memory_order_relaxed) * arenaSize;
+        uint64_t bytes_in_free_list = (freeList.size() + cache.capacity()) * sizeof(void*);
         return bytes_in_arenas + bytes_in_free_list;
     }
 
     uint64_t getUndeletedEntries() {
-        return numAlloc - numFree;
+        return numAlloc - numLocalFree - numRemoteFree;
     }
+
+    uint64_t getLocalFrees() const { return numLocalFree.load(std::memory_order_relaxed); }
+    uint64_t getRemoteFrees() const { return numRemoteFree.load(std::memory_order_relaxed); }
+    /** Number of elements the current arenas can hold */
+    uint64_t getCapacity() const { return numArenas.load(std::memory_order_relaxed) * elemsPerArena(); }
+    /** Total bytes of arenas returned to the OS */
+    uint64_t getBytesReclaimed() const { return bytesReclaimed.load(std::memory_order_relaxed); }
     
     /** Counter:  Number of times elements have been allocated */
     std::atomic<uint64_t> numAlloc;
-    /** Counter:  Number times elements have been freed */
-    std::atomic<uint64_t> numFree;
+    /** Counter:  Number times elements have been freed by the owner */
+    std::atomic<uint64_t> numLocalFree;
 
     size_t getArenaSize() const { return arenaSize; }
     size_t getElementSize() const { return elemSize; }
 
-    const std::list<uint8_t*>& getArenas() { return arenas; }
+    const std::vector<uint8_t*>& getArenas() { return arenas; }
     
 private:
 
+    /** Occupies the first element slot of every arena */
+    struct ArenaHeader {
+        void*  reserved;    /*!< Always NULL, so the slot reads as free */
+        size_t live;        /*!< Elements in use.  Only touched by the owner. */
+    };
+    static const size_t releasedArena = ~(size_t)0;
+
+    static HugePageMode& hugePageMode() {
+        static HugePageMode mode = HUGEPAGE_NONE;
+        return mode;
+    }
+
+    /** Arenas are aligned to their size, so this is just a mask */
+    inline ArenaHeader* arenaOf(void* ptr) const {
+        return (ArenaHeader*)((uintptr_t)ptr & ~(uintptr_t)(arenaSize - 1));
+    }
+
+    size_t elemsPerArena() const { return arenaSize / elemSize - 1; }
+
+    /** Map a new arena, aligned to arenaSize, according to the huge
+     * page mode.  Returns NULL on failure. */
+    uint8_t* mapArena()
+    {
+        void *ptr;
+        HugePageMode mode = hugePageMode();
+#ifdef MAP_HUGETLB
+        if ( HUGEPAGE_EXPLICIT == mode ) {
+            ptr = mmap(0, arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON|MAP_HUGETLB, -1, 0);
+            if ( MAP_FAILED != ptr ) {
+                if ( 0 == ((uintptr_t)ptr & (arenaSize - 1)) ) return (uint8_t*)ptr;
+                ::munmap(ptr, arenaSize);
+            }
+            // No suitable huge pages, try transparent ones instead
+        }
+#endif
+        // Over-allocate, then trim so the arena is aligned to its size.
+        // This also lets transparent huge pages back the arena.
+        ptr = mmap(0, 2 * arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
+        if ( MAP_FAILED == ptr ) return NULL;
+        uint8_t *raw = (uint8_t*)ptr;
+        uint8_t *start = (uint8_t*)(((uintptr_t)raw + arenaSize - 1) & ~(uintptr_t)(arenaSize - 1));
+        if ( start != raw ) ::munmap(raw, start - raw);
+        if ( start != raw + arenaSize ) ::munmap(start + arenaSize, raw + arenaSize - start);
+#ifdef MADV_HUGEPAGE
+        if ( HUGEPAGE_NONE != mode ) madvise(start, arenaSize, MADV_HUGEPAGE);
+#endif
+        return start;
+    }
+
+    /** Move everything on the return queue into the cache */
+    size_t takeRemoteFrees()
+    {
+        if ( NULL == remoteHead.load(std::memory_order_relaxed) ) return 0;
+        void* ptr = remoteHead.exchange(NULL, std::memory_order_acquire);
+        size_t count = 0;
+        while ( ptr ) {
+            void* next = ((void**)ptr)[1];
+            cache.push_back(ptr);
+            if ( 0 == --arenaOf(ptr)->live ) ++emptyArenas;
+            ptr = next;
+            ++count;
+        }
+        return count;
+    }
+
+    /** Move the cache down to cacheLimit - cacheBatch elements */
+    void spillCache()
+    {
+        if ( cache.size() <= cacheLimit - cacheBatch ) return;
+        size_t excess = cache.size() - (cacheLimit - cacheBatch);
+        freeList.insert(&cache[cache.size() - excess], excess);
+        cache.resize(cache.size() - excess);
+    }
+
+    /** Reclaim empty arenas once more than half of the pool, and at
+     * least two arenas' worth, is free */
+    void maybeReclaim()
+    {
+        if ( emptyArenas == 0 || arenas.size() <= 1 ) return;
+        uint64_t live = getUndeletedEntries();
+        uint64_t nfree = getCapacity() - live;
+        if ( nfree < 2 * elemsPerArena() || nfree < live ) return;
+        reclaim();
+    }
+
+    /** Refill the cache from the free list, allocating a new arena if
+     * the free list is empty */
+    bool refill()
+    {
+        // Draining may reclaim arenas, so the cache can still be empty
+        drainRemoteFrees();
+        while ( cache.empty() ) {
+            if ( 0 == freeList.try_remove(cache, cacheBatch) && !allocPool() ) return false;
+        }
+        return true;
+    }
+
 	bool allocPool()
     {
         /* If already in progress, return */
@@ -137,32 +354,48 @@ private:
             return true;
         }
 
-        uint8_t *newPool = (uint8_t*)mmap(0, arenaSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
-        if ( MAP_FAILED == newPool ) {
+        uint8_t *newPool = mapArena();
+        if ( NULL == newPool ) {
             allocating.store(0, std::memory_order_release);
             return false;
         }
+        // Arenas are only grown by the owning thread, so this is the
+        // first touch and the pages land on the owner's NUMA node
         std::memset(newPool, 0xFF, arenaSize); 
+        ArenaHeader* header = (ArenaHeader*)newPool;
+        header->reserved = NULL;
+        header->live = 0;
+        ++emptyArenas;
         arenas.push_back(newPool);
-        size_t nelem = arenaSize / elemSize;
+        numArenas.store(arenas.size(), std::memory_order_relaxed);
+        size_t nelem = elemsPerArena();
+        std::vector<void*> elems(nelem);
         for ( size_t i = 0 ; i < nelem ; i++ ) {
-            uint64_t* ptr = (uint64_t*)(newPool + (elemSize*i));
-// #ifdef __SST_DEBUG_EVENT_TRACKING__
-//             *ptr = 0xFFFFFFFFFFFFFFFF;
-// #endif
-            freeList.insert(ptr);
-            // freeList.push_back(newPool + (elemSize*i));
+            // Reversed, so elements are handed out in address order
+            elems[i] = newPool + (elemSize*(nelem - i));
         }
+        freeList.insert(elems.data(), nelem);
         allocating.store(0, std::memory_order_release);
         return true;
     }
 
 	size_t elemSize;
 	size_t arenaSize;
+    const void* owner;
 
     std::atomic<unsigned int> allocating;
 	FreeList<ThreadSafe::Spinlock> freeList;
-	std::list<uint8_t*> arenas;
+    std::vector<void*> cache;  /*!< Only touched by the owning thread */
+	std::vector<uint8_t*> arenas;
+    std::atomic<size_t> numArenas;  /*!< For reporting from other threads */
+    size_t emptyArenas;             /*!< Arenas with no live elements */
+    std::atomic<uint64_t> bytesReclaimed;
+
+    // Written by other threads, so kept off the owner's cache lines
+    uint8_t padding[64];
+    std::atomic<void*> remoteHead;     /*!< Return queue for remote frees */
+    /** Counter:  Number times elements have been freed by other threads */
+    std::atomic<uint64_t> numRemoteFree;
 
 };
 
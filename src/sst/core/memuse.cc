@@ -16,11 +16,7 @@
 #include <sst/core/warnmacros.h>
 #include <sys/resource.h>
 
-#ifdef SST_CONFIG_HAVE_MPI
-DISABLE_WARN_MISSING_OVERRIDE
-#include <mpi.h>
-REENABLE_WARNING
-#endif
+#include <sst/core/objectComms.h>
 
 
 using namespace SST::Core;
@@ -31,10 +27,7 @@ uint64_t SST::Core::maxLocalMemSize() {
     getrusage(RUSAGE_SELF, &sim_ruse);
 
     uint64_t local_max_rss = sim_ruse.ru_maxrss;
-    uint64_t global_max_rss = local_max_rss;
-#ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_max_rss, &global_max_rss, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-#endif
+    uint64_t global_max_rss = Comms::all_reduce(local_max_rss, Comms::REDUCE_MAX);
 
 #ifdef SST_COMPILE_MACOSX
 	return (global_max_rss / 1024);
@@ -49,10 +42,7 @@ uint64_t SST::Core::maxGlobalMemSize() {
     getrusage(RUSAGE_SELF, &sim_ruse);
 
     uint64_t local_max_rss = sim_ruse.ru_maxrss;
-    uint64_t global_max_rss = local_max_rss;
-#ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_max_rss, &global_max_rss, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-#endif
+    uint64_t global_max_rss = Comms::all_reduce(local_max_rss, Comms::REDUCE_SUM);
 
 #ifdef SST_COMPILE_MACOSX
 	return (global_max_rss / 1024);
@@ -67,10 +57,7 @@ uint64_t SST::Core::maxLocalPageFaults() {
     getrusage(RUSAGE_SELF, &sim_ruse);
     
     uint64_t local_pf = sim_ruse.ru_majflt;
-    uint64_t global_max_pf = local_pf;
-#ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_pf, &global_max_pf, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-#endif
+    uint64_t global_max_pf = Comms::all_reduce(local_pf, Comms::REDUCE_MAX);
 	return global_max_pf;
 };
 
@@ -79,10 +66,7 @@ uint64_t SST::Core::globalPageFaults() {
     getrusage(RUSAGE_SELF, &sim_ruse);
 
     uint64_t local_pf = sim_ruse.ru_majflt;
-    uint64_t global_pf = local_pf;
-#ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_pf, &global_pf, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-#endif
+    uint64_t global_pf = Comms::all_reduce(local_pf, Comms::REDUCE_SUM);
 
 	return global_pf;
 };
@@ -0,0 +1,96 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+// 
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+// 
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include <sst/core/objectComms.h>
+
+#include <sst/core/interprocess/rankTunnel.h>
+
+using SST::Core::Interprocess::RankTunnel;
+
+namespace SST {
+namespace Comms {
+
+static RankTunnel::ReduceOp
+tunnelOp(ReduceOp op)
+{
+    switch ( op ) {
+    case REDUCE_MIN: return RankTunnel::MIN;
+    case REDUCE_MAX: return RankTunnel::MAX;
+    default: return RankTunnel::SUM;
+    }
+}
+
+#ifdef SST_CONFIG_HAVE_MPI
+static MPI_Op
+mpiOp(ReduceOp op)
+{
+    switch ( op ) {
+    case REDUCE_MIN: return MPI_MIN;
+    case REDUCE_MAX: return MPI_MAX;
+    default: return MPI_SUM;
+    }
+}
+#endif
+
+int
+all_reduce(int value, ReduceOp op)
+{
+    if ( RankTunnel* tunnel = RankTunnel::get() ) return tunnel->allreduce(value, tunnelOp(op));
+#ifdef SST_CONFIG_HAVE_MPI
+    int out;
+    MPI_Allreduce(&value, &out, 1, MPI_INT, mpiOp(op), MPI_COMM_WORLD);
+    return out;
+#else
+    return value;
+#endif
+}
+
+uint64_t
+all_reduce(uint64_t value, ReduceOp op)
+{
+    if ( RankTunnel* tunnel = RankTunnel::get() ) return tunnel->allreduce(value, tunnelOp(op));
+#ifdef SST_CONFIG_HAVE_MPI
+    uint64_t out;
+    MPI_Allreduce(&value, &out, 1, MPI_UINT64_T, mpiOp(op), MPI_COMM_WORLD);
+    return out;
+#else
+    return value;
+#endif
+}
+
+double
+all_reduce(double value, ReduceOp op)
+{
+    if ( RankTunnel* tunnel = RankTunnel::get() ) return tunnel->allreduce(value, tunnelOp(op));
+#ifdef SST_CONFIG_HAVE_MPI
+    double out;
+    MPI_Allreduce(&value, &out, 1, MPI_DOUBLE, mpiOp(op), MPI_COMM_WORLD);
+    return out;
+#else
+    return value;
+#endif
+}
+
+void
+barrier()
+{
+    if ( RankTunnel* tunnel = RankTunnel::get() ) {
+        tunnel->barrier();
+        return;
+    }
+#ifdef SST_CONFIG_HAVE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+} // namespace Comms
+} // namespace SST
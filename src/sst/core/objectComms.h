@@ -227,6 +227,20 @@ void all_gather(dataType& data, std::vector<dataType> &out_data) {
 
 #endif
 
+/** Operations for all_reduce() */
+enum ReduceOp { REDUCE_MIN, REDUCE_MAX, REDUCE_SUM };
+
+/**
+ * Combine value across all ranks, over MPI or, with --ipc-ranks, the
+ * shared-memory RankTunnel.  With one rank, returns value.
+ */
+int all_reduce(int value, ReduceOp op);
+uint64_t all_reduce(uint64_t value, ReduceOp op);
+double all_reduce(double value, ReduceOp op);
+
+/** Wait for all ranks */
+void barrier();
+
 }
 
 } //namespace SST
@@ -48,8 +48,12 @@ RankSyncParallelSkip::RankSyncParallelSkip(RankInfo num_ranks, TimeConverter* UN
     allDoneBarrier(num_ranks.thread)
 {
     // TraceFunction(CALL_INFO_LONG);
+    serializeReadyBarrier.setName("RankSyncParallelSkip::serializeReady");
+    slaveExchangeDoneBarrier.setName("RankSyncParallelSkip::slaveExchangeDone");
+    allDoneBarrier.setName("RankSyncParallelSkip::allDone");
     max_period = Simulation::getSimulation()->getMinPartTC();
     myNextSyncTime = max_period->getFactor();
+    adaptive = Simulation::getSimulation()->getAdaptiveSync();
     recv_count = new int[num_ranks.thread];
     for ( uint32_t i = 0; i < num_ranks.thread; i++ ) {
         recv_count[i] = 0;
@@ -262,7 +266,7 @@ RankSyncParallelSkip::exchange_master(int UNUSED(thread))
                 hdr->mode = 1;
                 MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
                           send->to_rank.rank/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-                send->remote_size = hdr->buffer_size;
+                send->remote_size = SyncQueue::growReceiveSize(send->remote_size, hdr->buffer_size);
                 tag = 2 * send->to_rank.thread + 1;
             }
             else {
@@ -304,8 +308,8 @@ RankSyncParallelSkip::exchange_master(int UNUSED(thread))
                         // May need to resize the buffer
                         if ( size > i->second.local_size ) {
                             delete[] i->second.rbuf;
-                            i->second.rbuf = new char[size];
-                            i->second.local_size = size;
+                            i->second.local_size = SyncQueue::growReceiveSize(i->second.local_size, size);
+                            i->second.rbuf = new char[i->second.local_size];
                         }
                         MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
                                  i->second.remote_rank, 2 * i->second.local_thread + 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
@@ -333,15 +337,17 @@ RankSyncParallelSkip::exchange_master(int UNUSED(thread))
     
     // Check to see when the next event is scheduled, then do an
     // all_reduce with min operator and set next sync time to be
-    // min + max_period.
+    // min + max_period.  In adaptive mode each rank contributes the
+    // earliest time it could send to another rank instead, and the
+    // minimum of those is the next time any rank can be affected.
 
     // Need to get the local minimum, then do a global minimum
     // SimTime_t input = Simulation::getSimulation()->getNextActivityTime();
-    SimTime_t input = Simulation::getLocalMinimumNextActivityTime();
+    SimTime_t input = adaptive ? Simulation::getLocalMinimumNextRankSendTime() : Simulation::getLocalMinimumNextActivityTime();
     SimTime_t min_time;
     MPI_Allreduce( &input, &min_time, 1, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD );
 
-    myNextSyncTime = min_time + max_period->getFactor();
+    myNextSyncTime = adaptive ? min_time : min_time + max_period->getFactor();
     
 #endif
 }
@@ -381,7 +387,7 @@ RankSyncParallelSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::at
             hdr->mode = 1;
             MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
                       i->second.to_rank.rank/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-            i->second.remote_size = hdr->buffer_size;
+            i->second.remote_size = SyncQueue::growReceiveSize(i->second.remote_size, hdr->buffer_size);
             tag = 2 * i->second.to_rank.thread + 1;
         }
         else {
@@ -409,19 +415,16 @@ RankSyncParallelSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::at
             // May need to resize the buffer
             if ( size > i->second.local_size ) {
                 delete[] i->second.rbuf;
-                i->second.rbuf = new char[size];
-                i->second.local_size = size;
+                i->second.local_size = SyncQueue::growReceiveSize(i->second.local_size, size);
+                i->second.rbuf = new char[i->second.local_size];
             }
             MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
                      i->second.remote_rank, 2 * i->second.local_thread + 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
             buffer = i->second.rbuf;
         }
 
-        SST::Core::Serialization::serializer ser;
-        ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        
         std::vector<Activity*> activities;
-        ser & activities;
+        SyncQueue::unpack(buffer, activities);
 
         for ( unsigned int j = 0; j < activities.size(); j++ ) {
             
@@ -455,15 +458,10 @@ void
 RankSyncParallelSkip::deserializeMessage(comm_recv_pair* msg)
 {
     char* buffer = msg->rbuf;
-    SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
-    unsigned int size = hdr->buffer_size;
-    
+
     auto deserialStart = SST::Core::Profile::now();
 
-    SST::Core::Serialization::serializer ser;
-    
-    ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-    ser & msg->activity_vec;
+    SyncQueue::unpack(buffer, msg->activity_vec);
 
     deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
 }
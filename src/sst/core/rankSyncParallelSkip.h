@@ -89,6 +89,8 @@ private:
 
     double mpiWaitTime;
     double deserializeTime;
+    /** Set when syncs are scheduled from each rank's earliest possible send */
+    bool adaptive;
 
     int* recv_count;
     int send_count;
@@ -46,6 +46,7 @@ RankSyncSerialSkip::RankSyncSerialSkip(TimeConverter* UNUSED(minPartTC)) :
 {
     max_period = Simulation::getSimulation()->getMinPartTC();
     myNextSyncTime = max_period->getFactor();
+    adaptive = Simulation::getSimulation()->getAdaptiveSync();
 }
 
 RankSyncSerialSkip::~RankSyncSerialSkip()
@@ -126,6 +127,10 @@ RankSyncSerialSkip::exchange(void)
     MPI_Request rreqs[comm_map.size()];
     int sreq_count = 0;
     int rreq_count = 0;
+    // The peer each receive is from, and whether it is the resend that
+    // follows a resize
+    comm_map_t::iterator peers[comm_map.size()];
+    bool resent[comm_map.size()];
     
     for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
         
@@ -142,7 +147,7 @@ RankSyncSerialSkip::exchange(void)
             hdr->mode = 1;
             MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
                       i->first/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-            i->second.remote_size = hdr->buffer_size;
+            i->second.remote_size = SyncQueue::growReceiveSize(i->second.remote_size, hdr->buffer_size);
             tag = 2;
         }
         else {
@@ -152,19 +157,25 @@ RankSyncSerialSkip::exchange(void)
                   i->first/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
         
         // Post all the receives
+        peers[rreq_count] = i;
+        resent[rreq_count] = false;
         MPI_Irecv(i->second.rbuf, i->second.local_size, MPI_BYTE,
                   i->first, 1, MPI_COMM_WORLD, &rreqs[rreq_count++]);
     }
     
-    // Wait for all sends and recvs to complete
+    // Deserialize and deliver from each rank as soon as its data
+    // arrives, so the work overlaps the receives still in flight
     Simulation* sim = Simulation::getSimulation();
     SimTime_t current_cycle = sim->getCurrentSimCycle();
-    
-    auto waitStart = SST::Core::Profile::now();
-    MPI_Waitall(rreq_count, rreqs, MPI_STATUSES_IGNORE);
-    mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
-    
-    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+
+    while ( true ) {
+        int index;
+        auto waitStart = SST::Core::Profile::now();
+        MPI_Waitany(rreq_count, rreqs, &index, MPI_STATUS_IGNORE);
+        mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+        if ( index == MPI_UNDEFINED ) break;
+
+        comm_map_t::iterator i = peers[index];
         // Get the buffer and deserialize all the events
         char* buffer = i->second.rbuf;
         
@@ -172,26 +183,24 @@ RankSyncSerialSkip::exchange(void)
         unsigned int size = hdr->buffer_size;
         int mode = hdr->mode;
         
-        if ( mode == 1 ) {
-            // May need to resize the buffer
+        if ( mode == 1 && !resent[index] ) {
+            // May need to resize the buffer, then wait for the data
+            // along with everything else
             if ( size > i->second.local_size ) {
                 delete[] i->second.rbuf;
-                i->second.rbuf = new char[size];
-                i->second.local_size = size;
+                i->second.local_size = SyncQueue::growReceiveSize(i->second.local_size, size);
+                i->second.rbuf = new char[i->second.local_size];
             }
-            MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
-                     i->first, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-            buffer = i->second.rbuf;
+            resent[index] = true;
+            MPI_Irecv(i->second.rbuf, i->second.local_size, MPI_BYTE,
+                      i->first, 2, MPI_COMM_WORLD, &rreqs[index]);
+            continue;
         }
         
         auto deserialStart = SST::Core::Profile::now();
 
-        SST::Core::Serialization::serializer ser;
-        ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-
         std::vector<Activity*> activities;
-        activities.clear();
-        ser & activities;
+        SyncQueue::unpack(buffer, activities);
         
         deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
 
@@ -208,12 +217,10 @@ RankSyncSerialSkip::exchange(void)
             }
         }
 
-        activities.clear();
-
     }
 
     // Clear the SyncQueues used to send the data after all the sends have completed
-    waitStart = SST::Core::Profile::now();
+    auto waitStart = SST::Core::Profile::now();
     MPI_Waitall(sreq_count, sreqs, MPI_STATUSES_IGNORE);
     mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
     
@@ -226,15 +233,17 @@ RankSyncSerialSkip::exchange(void)
     
     // Check to see when the next event is scheduled, then do an
     // all_reduce with min operator and set next sync time to be
-    // min + max_period.
+    // min + max_period.  In adaptive mode each rank contributes the
+    // earliest time it could send to another rank instead, and the
+    // minimum of those is the next time any rank can be affected.
 
     // Need to get the local minimum, then do a global minimum
     // SimTime_t input = Simulation::getSimulation()->getNextActivityTime();
-    SimTime_t input = Simulation::getLocalMinimumNextActivityTime();
+    SimTime_t input = adaptive ? Simulation::getLocalMinimumNextRankSendTime() : Simulation::getLocalMinimumNextActivityTime();
     SimTime_t min_time;
     MPI_Allreduce( &input, &min_time, 1, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD );
 
-    myNextSyncTime = min_time + max_period->getFactor();
+    myNextSyncTime = adaptive ? min_time : min_time + max_period->getFactor();
 #endif
 }
 
@@ -265,7 +274,7 @@ RankSyncSerialSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::atom
             // not big enough, send message that will tell remote side to get larger buffer
             hdr->mode = 1;
             MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE, i->first/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-            i->second.remote_size = hdr->buffer_size;
+            i->second.remote_size = SyncQueue::growReceiveSize(i->second.remote_size, hdr->buffer_size);
             tag = 2;
         }
         else {
@@ -295,18 +304,15 @@ RankSyncSerialSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::atom
             // May need to resize the buffer
             if ( size > i->second.local_size ) {
                 delete[] i->second.rbuf;
-                i->second.rbuf = new char[size];
-                i->second.local_size = size;
+                i->second.local_size = SyncQueue::growReceiveSize(i->second.local_size, size);
+                i->second.rbuf = new char[i->second.local_size];
             }
             MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE, i->first, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
             buffer = i->second.rbuf;
         }
         
-        SST::Core::Serialization::serializer ser;
-        ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        
         std::vector<Activity*> activities;
-        ser & activities;
+        SyncQueue::unpack(buffer, activities);
         for ( unsigned int j = 0; j < activities.size(); j++ ) {
             
             Event* ev = static_cast<Event*>(activities[j]);
@@ -44,7 +44,7 @@ public:
     
     uint64_t getDataSize() const override;
     
-private:
+protected:
 
     static SimTime_t myNextSyncTime;
 
@@ -67,6 +67,8 @@ private:
 
     double mpiWaitTime;
     double deserializeTime;
+    /** Set when syncs are scheduled from each rank's earliest possible send */
+    bool adaptive;
 
 };
 
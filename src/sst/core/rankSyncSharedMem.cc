@@ -0,0 +1,147 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/rankSyncSharedMem.h"
+
+#include "sst/core/event.h"
+#include "sst/core/link.h"
+#include "sst/core/objectComms.h"
+#include "sst/core/simulation.h"
+#include "sst/core/syncQueue.h"
+#include "sst/core/timeConverter.h"
+#include "sst/core/profile.h"
+#include "sst/core/interprocess/rankTunnel.h"
+
+namespace SST {
+
+using Core::Interprocess::RankTunnel;
+
+RankSyncSharedMem::RankSyncSharedMem(RankInfo num_ranks, TimeConverter* minPartTC) :
+    RankSyncSerialSkip(minPartTC),
+    tunnel(RankTunnel::get()),
+    num_threads(num_ranks.thread),
+    incoming(num_ranks.thread)
+{
+    barrier.resize(num_threads);
+    barrier.setName("RankSyncSharedMem");
+}
+
+RankSyncSharedMem::~RankSyncSharedMem()
+{
+}
+
+ActivityQueue*
+RankSyncSharedMem::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link)
+{
+    link_thread[link_id] = from_rank.thread;
+    return RankSyncSerialSkip::registerLink(to_rank, from_rank, link_id, link);
+}
+
+void
+RankSyncSharedMem::execute(int thread)
+{
+    if ( thread == 0 ) {
+        std::vector<Activity*> activities;
+        transfer(activities);
+
+        for ( unsigned int j = 0; j < activities.size(); j++ ) {
+            Event* ev = static_cast<Event*>(activities[j]);
+            auto owner = link_thread.find(ev->getLinkId());
+            if ( owner == link_thread.end() ) {
+                Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+            }
+            incoming[owner->second].push_back(ev);
+        }
+
+        // Same schedule as RankSyncSerialSkip
+        SimTime_t input = adaptive ? Simulation::getLocalMinimumNextRankSendTime() : Simulation::getLocalMinimumNextActivityTime();
+        SimTime_t min_time = tunnel->allreduce(input, RankTunnel::MIN);
+        myNextSyncTime = adaptive ? min_time : min_time + max_period->getFactor();
+    }
+
+    // Each thread puts the events for its own links into its own
+    // TimeVortex
+    if ( num_threads > 1 ) barrier.wait();
+    deliver(thread);
+}
+
+void
+RankSyncSharedMem::deliver(int thread)
+{
+    std::vector<Activity*>& activities = incoming[thread];
+    SimTime_t current_cycle = Simulation::getSimulation()->getCurrentSimCycle();
+    for ( unsigned int j = 0; j < activities.size(); j++ ) {
+        Event* ev = static_cast<Event*>(activities[j]);
+        link_map_t::iterator link = link_map.find(ev->getLinkId());
+        if (link == link_map.end()) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+        } else {
+            // Need to figure out what the "delay" is for this event.
+            SimTime_t delay = ev->getDeliveryTime() - current_cycle;
+            link->second->send(delay,ev);
+        }
+    }
+    activities.clear();
+}
+
+void
+RankSyncSharedMem::transfer(std::vector<Activity*>& activities)
+{
+    peers.clear();
+    sends.clear();
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        // The tunnel streams the data, so the receiver never needs to
+        // be told to resize
+        char* send_buffer = i->second.squeue->getData();
+        SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(send_buffer);
+        hdr->mode = 0;
+        peers.push_back(i->first);
+        sends.push_back(std::make_pair(send_buffer, static_cast<size_t>(hdr->buffer_size)));
+    }
+
+    auto waitStart = SST::Core::Profile::now();
+    tunnel->exchange(peers, sends, recvs);
+    mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+
+    auto deserialStart = SST::Core::Profile::now();
+    std::vector<Activity*> batch;
+    for ( size_t i = 0; i < recvs.size(); i++ ) {
+        SyncQueue::unpack(recvs[i].data(), batch);
+        activities.insert(activities.end(), batch.begin(), batch.end());
+    }
+    deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
+}
+
+void
+RankSyncSharedMem::exchangeLinkUntimedData(int thread, std::atomic<int>& msg_count)
+{
+    if ( thread != 0 ) {
+        return;
+    }
+
+    std::vector<Activity*> activities;
+    transfer(activities);
+    for ( unsigned int j = 0; j < activities.size(); j++ ) {
+        Event* ev = static_cast<Event*>(activities[j]);
+        link_map_t::iterator link = link_map.find(ev->getLinkId());
+        if (link == link_map.end()) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+        } else {
+            sendUntimedData_sync(link->second,ev);
+        }
+    }
+
+    // See if there were any messages sent on any rank
+    msg_count = Comms::all_reduce(static_cast<int>(msg_count), Comms::REDUCE_SUM);
+}
+
+} // namespace SST
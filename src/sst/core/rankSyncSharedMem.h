@@ -0,0 +1,70 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_RANKSYNCSHAREDMEM_H
+#define SST_CORE_RANKSYNCSHAREDMEM_H
+
+#include "sst/core/sst_types.h"
+#include <sst/core/rankSyncSerialSkip.h>
+#include <sst/core/threadsafe.h>
+
+#include <vector>
+
+namespace SST {
+
+namespace Core {
+namespace Interprocess {
+class RankTunnel;
+}
+}
+
+/**
+ * Rank sync for ranks run as processes on one node with --ipc-ranks.
+ * Syncs are scheduled as in RankSyncSerialSkip, but the SyncQueues
+ * go through the shared-memory RankTunnel instead of MPI.  Thread 0
+ * does the exchange and each thread delivers the events for its own
+ * links.
+ */
+class RankSyncSharedMem : public RankSyncSerialSkip {
+public:
+    /** Create a new Sync object which fires with a specified period */
+    RankSyncSharedMem(RankInfo num_ranks, TimeConverter* minPartTC);
+    virtual ~RankSyncSharedMem();
+
+    /** Register a Link which this Sync Object is responsible for */
+    ActivityQueue* registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link) override;
+    void execute(int thread) override;
+
+    /** Cause an exchange of Untimed Data to occur */
+    void exchangeLinkUntimedData(int thread, std::atomic<int>& msg_count) override;
+
+private:
+    /** Send every SyncQueue to its rank and unpack what the other
+     * ranks sent into activities */
+    void transfer(std::vector<Activity*>& activities);
+    void deliver(int thread);
+
+    Core::Interprocess::RankTunnel* tunnel;
+    int num_threads;
+
+    std::map<LinkId_t, int> link_thread;
+    std::vector<std::vector<Activity*> > incoming;
+
+    std::vector<int> peers;
+    std::vector<std::pair<const char*, size_t> > sends;
+    std::vector<std::vector<char> > recvs;
+
+    Core::ThreadSafe::Barrier barrier;
+};
+
+} // namespace SST
+
+#endif // SST_CORE_RANKSYNCSHAREDMEM_H
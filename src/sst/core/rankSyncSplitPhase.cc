@@ -0,0 +1,247 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/rankSyncSplitPhase.h"
+
+#include "sst/core/event.h"
+#include "sst/core/exit.h"
+#include "sst/core/link.h"
+#include "sst/core/simulation.h"
+#include "sst/core/syncQueue.h"
+#include "sst/core/timeConverter.h"
+#include "sst/core/profile.h"
+
+namespace SST {
+
+RankSyncSplitPhase::RankSyncSplitPhase(RankInfo num_ranks, TimeConverter* minPartTC) :
+    RankSyncSerialSkip(minPartTC),
+    num_threads(num_ranks.thread),
+    posted(false),
+    incoming(num_ranks.thread)
+{
+    SimTime_t period = max_period->getFactor();
+    half_period = period / 2;
+    if ( half_period == 0 ) half_period = 1;
+
+    // Nothing is sent before time 0
+    send_bound = period;
+    myNextSyncTime = half_period;
+
+    barrier.resize(num_threads);
+    barrier.setName("RankSyncSplitPhase");
+}
+
+RankSyncSplitPhase::~RankSyncSplitPhase()
+{
+}
+
+ActivityQueue*
+RankSyncSplitPhase::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link)
+{
+    link_thread[link_id] = from_rank.thread;
+    return RankSyncSerialSkip::registerLink(to_rank, from_rank, link_id, link);
+}
+
+void
+RankSyncSplitPhase::prepareForComplete()
+{
+    // Every rank posted the same number of exchanges, so the last one
+    // can be finished here.  What it carries is past the end of
+    // simulation.
+    finish();
+    for ( int i = 0; i < num_threads; i++ ) {
+        for ( size_t j = 0; j < incoming[i].size(); j++ ) {
+            delete incoming[i][j];
+        }
+        incoming[i].clear();
+    }
+    RankSyncSerialSkip::prepareForComplete();
+}
+
+void
+RankSyncSplitPhase::execute(int thread)
+{
+    if ( thread == 0 ) {
+        Exit* exit = Simulation::getSimulation()->getExit();
+        if ( finish() ) {
+            // The exit check posted with the last exchange
+            if ( reduce_out[reduce_done] ) {
+                exit->setGlobalCount(0, MAX_SIMTIME_T - reduce_out[reduce_end]);
+            }
+            else {
+                exit->setGlobalCount(1, exit->getEndTime());
+            }
+        }
+        else {
+            exit->setGlobalCount(1, exit->getEndTime());
+        }
+    }
+
+    // Each thread puts the events for its own links into its own
+    // TimeVortex
+    barrier.wait();
+    deliver(thread);
+    barrier.wait();
+
+    if ( thread == 0 ) post();
+}
+
+void
+RankSyncSplitPhase::deliver(int thread)
+{
+    std::vector<Activity*>& activities = incoming[thread];
+    SimTime_t current_cycle = Simulation::getSimulation()->getCurrentSimCycle();
+    for ( unsigned int j = 0; j < activities.size(); j++ ) {
+        Event* ev = static_cast<Event*>(activities[j]);
+        link_map_t::iterator link = link_map.find(ev->getLinkId());
+        if (link == link_map.end()) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+        } else {
+            // Need to figure out what the "delay" is for this event.
+            SimTime_t delay = ev->getDeliveryTime() - current_cycle;
+            link->second->send(delay,ev);
+        }
+    }
+    activities.clear();
+}
+
+void
+RankSyncSplitPhase::post()
+{
+    Simulation* sim = Simulation::getSimulation();
+    SimTime_t current_cycle = sim->getCurrentSimCycle();
+
+#ifdef SST_CONFIG_HAVE_MPI
+    sreqs.clear();
+    rreqs.clear();
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+
+        // Do all the sends
+        char* send_buffer = i->second.squeue->getData();
+        SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(send_buffer);
+        int tag = 1;
+        // Check to see if remote queue is big enough for data
+        if ( i->second.remote_size < hdr->buffer_size ) {
+            // not big enough, send message that will tell remote side to get larger buffer
+            hdr->mode = 1;
+            sreqs.push_back(MPI_Request());
+            MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
+                      i->first/*dest*/, tag, MPI_COMM_WORLD, &sreqs.back());
+            i->second.remote_size = SyncQueue::growReceiveSize(i->second.remote_size, hdr->buffer_size);
+            tag = 2;
+        }
+        else {
+            hdr->mode = 0;
+        }
+        sreqs.push_back(MPI_Request());
+        MPI_Isend(send_buffer, hdr->buffer_size, MPI_BYTE,
+                  i->first/*dest*/, tag, MPI_COMM_WORLD, &sreqs.back());
+
+        // Post all the receives
+        rreqs.push_back(MPI_Request());
+        MPI_Irecv(i->second.rbuf, i->second.local_size, MPI_BYTE,
+                  i->first, 1, MPI_COMM_WORLD, &rreqs.back());
+    }
+
+    // The next activity time and the exit check go out with the
+    // exchange.  The end time is reduced with MPI_MIN as well, so it
+    // is stored as its distance from the maximum.
+    Exit* exit = sim->getExit();
+    reduce_in[reduce_next] = adaptive ? Simulation::getLocalMinimumNextRankSendTime() : Simulation::getLocalMinimumNextActivityTime();
+    reduce_in[reduce_done] = ( exit->getRefCount() == 0 );
+    reduce_in[reduce_end] = MAX_SIMTIME_T - exit->getEndTime();
+    MPI_Iallreduce(reduce_in, reduce_out, reduce_count, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD, &reduce_req);
+    posted = true;
+#endif
+
+    // What was just posted is finished at the next sync, so that sync
+    // has to come before anything in it can arrive.  The sync after
+    // that is bounded by what is sent from here on, which is not
+    // known until the reduction finishes, but cannot be earlier than
+    // a full lookahead from now.
+    SimTime_t next = current_cycle + half_period;
+    myNextSyncTime = send_bound < next ? send_bound : next;
+}
+
+bool
+RankSyncSplitPhase::finish()
+{
+#ifdef SST_CONFIG_HAVE_MPI
+    if ( !posted ) return false;
+    posted = false;
+
+    auto waitStart = SST::Core::Profile::now();
+    MPI_Waitall(rreqs.size(), rreqs.data(), MPI_STATUSES_IGNORE);
+    mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        // Get the buffer and deserialize all the events
+        char* buffer = i->second.rbuf;
+
+        SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
+        unsigned int size = hdr->buffer_size;
+        int mode = hdr->mode;
+
+        if ( mode == 1 ) {
+            // May need to resize the buffer
+            if ( size > i->second.local_size ) {
+                delete[] i->second.rbuf;
+                i->second.local_size = SyncQueue::growReceiveSize(i->second.local_size, size);
+                i->second.rbuf = new char[i->second.local_size];
+            }
+            MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
+                     i->first, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            buffer = i->second.rbuf;
+        }
+
+        auto deserialStart = SST::Core::Profile::now();
+
+        std::vector<Activity*> activities;
+        SyncQueue::unpack(buffer, activities);
+
+        deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
+
+        for ( unsigned int j = 0; j < activities.size(); j++ ) {
+            Event* ev = static_cast<Event*>(activities[j]);
+            auto thread = link_thread.find(ev->getLinkId());
+            if ( thread == link_thread.end() ) {
+                Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+            }
+            incoming[thread->second].push_back(ev);
+        }
+    }
+
+    waitStart = SST::Core::Profile::now();
+    MPI_Waitall(sreqs.size(), sreqs.data(), MPI_STATUSES_IGNORE);
+    MPI_Wait(&reduce_req, MPI_STATUS_IGNORE);
+    mpiWaitTime += SST::Core::Profile::getElapsed(waitStart);
+
+    // The SyncQueues were emptied when they were serialized and have
+    // been taking events for the next exchange since
+
+    // Everything sent after the sync that posted this exchange is
+    // bounded by the reduced time
+    SimTime_t next = reduce_out[reduce_next];
+    if ( adaptive ) {
+        send_bound = next;
+    }
+    else {
+        SimTime_t period = max_period->getFactor();
+        send_bound = next >= MAX_SIMTIME_T - period ? MAX_SIMTIME_T : next + period;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace SST
@@ -0,0 +1,88 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_RANKSYNCSPLITPHASE_H
+#define SST_CORE_RANKSYNCSPLITPHASE_H
+
+#include "sst/core/sst_types.h"
+#include <sst/core/rankSyncSerialSkip.h>
+#include <sst/core/threadsafe.h>
+#include <sst/core/warnmacros.h>
+
+#include <vector>
+
+#ifdef SST_CONFIG_HAVE_MPI
+DISABLE_WARN_MISSING_OVERRIDE
+#include <mpi.h>
+REENABLE_WARNING
+#endif
+
+namespace SST {
+
+/**
+ * Rank sync that overlaps its exchange with execution.  Each sync
+ * posts the events sent since the last one, along with the reduction
+ * of the next activity time and the exit check, and returns without
+ * waiting.  The next sync finishes the exchange before posting its
+ * own.  Syncs are scheduled at most half a lookahead apart, so
+ * anything posted at one sync cannot arrive before the next, and
+ * ranks get that half lookahead of execution to hide the exchange
+ * behind.  Idle stretches are skipped half a lookahead at a time.
+ */
+class RankSyncSplitPhase : public RankSyncSerialSkip {
+public:
+    /** Create a new Sync object which fires with a specified period */
+    RankSyncSplitPhase(RankInfo num_ranks, TimeConverter* minPartTC);
+    virtual ~RankSyncSplitPhase();
+
+    /** Register a Link which this Sync Object is responsible for */
+    ActivityQueue* registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link) override;
+    void execute(int thread) override;
+    bool checksExit() override { return true; }
+
+    /** Prepare for the complete() stage */
+    void prepareForComplete() override;
+
+private:
+    /** Post the sends and receives for this sync and the reduction */
+    void post();
+    /** Wait for the exchange posted at the last sync and sort what
+     * arrived by the thread that owns its link.  Returns false if
+     * nothing was posted. */
+    bool finish();
+    void deliver(int thread);
+
+    enum { reduce_next = 0, reduce_done, reduce_end, reduce_count };
+
+    int num_threads;
+    SimTime_t half_period;
+    /** Earliest time anything could be sent to another rank after the
+     * last sync whose reduction has finished */
+    SimTime_t send_bound;
+    bool posted;
+
+    std::map<LinkId_t, int> link_thread;
+    std::vector<std::vector<Activity*> > incoming;
+
+#ifdef SST_CONFIG_HAVE_MPI
+    std::vector<MPI_Request> sreqs;
+    std::vector<MPI_Request> rreqs;
+    MPI_Request reduce_req;
+#endif
+    uint64_t reduce_in[reduce_count];
+    uint64_t reduce_out[reduce_count];
+
+    Core::ThreadSafe::Barrier barrier;
+};
+
+} // namespace SST
+
+#endif // SST_CORE_RANKSYNCSPLITPHASE_H
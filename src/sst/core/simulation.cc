@@ -14,6 +14,7 @@
 #include <sst/core/simulation.h>
 #include <sst/core/warnmacros.h>
 
+#include <algorithm>
 #include <utility>
 
 //#include <sst/core/archive.h>
@@ -59,7 +60,7 @@ Simulation::~Simulation()
     // Clean up as best we can
 
     // Delete the timeVortex first.  This will delete all events left
-    // in the queue, as well as the Sync, Exit and Clock objects.
+    // in the queue, as well as the Sync and Exit objects.
     delete timeVortex;
 
     // Delete all the components
@@ -69,7 +70,10 @@ Simulation::~Simulation()
     // compMap.clear();
     
 
-    // Clocks already got deleted by timeVortex, simply clear the clockMap
+    // Clocks are never in the timeVortex, so delete them here
+    for ( auto && entry : clockMap ) {
+        delete entry.second;
+    }
     clockMap.clear();
     
     // OneShots already got deleted by timeVortex, simply clear the onsShotMap
@@ -101,11 +105,9 @@ Simulation::~Simulation()
 Simulation*
 Simulation::createSimulation(Config *config, RankInfo my_rank, RankInfo num_ranks, SimTime_t min_part)
 {
-    std::thread::id tid = std::this_thread::get_id();
-    Simulation* instance = new Simulation(config, my_rank, num_ranks, min_part);
+    instance = new Simulation(config, my_rank, num_ranks, min_part);
 
     std::lock_guard<std::mutex> lock(simulationMutex);
-    instanceMap[tid] = instance;
     instanceVec.resize(num_ranks.thread);
     instanceVec[my_rank.thread] = instance;
     return instance;
@@ -114,7 +116,7 @@ Simulation::createSimulation(Config *config, RankInfo my_rank, RankInfo num_rank
 
 void Simulation::shutdown()
 {
-    instanceMap.clear();
+    instance = NULL;
 }
 
 
@@ -123,6 +125,14 @@ Simulation::Simulation( Config* cfg, RankInfo my_rank, RankInfo num_ranks, SimTi
     runMode(cfg->runMode),
     timeVortex(NULL),
     interThreadMinLatency(MAX_SIMTIME_T),
+    threadSendLatency(MAX_SIMTIME_T),
+    rankSendLatency(MAX_SIMTIME_T),
+    threadSyncMode(cfg->threadSync),
+    threadDirectDelivery(cfg->thread_direct_delivery),
+    adaptiveSync(cfg->adaptive_sync),
+    splitRankSync(cfg->split_rank_sync),
+    rankSyncEncoding(cfg->rankSyncEncoding),
+    syncManager(NULL),
     threadSync(NULL),
     currentSimCycle(0),
     endSimCycle(0),
@@ -189,7 +199,7 @@ Simulation::requireEvent(std::string name)
 SimTime_t
 Simulation::getNextActivityTime() const
 {
-    return timeVortex->front()->getDeliveryTime();
+    return std::min(timeVortex->front()->getDeliveryTime(), clockScheduler.getNextTime());
 }
 
 SimTime_t
@@ -206,6 +216,40 @@ Simulation::getLocalMinimumNextActivityTime()
     return ret;
 }
 
+SimTime_t
+Simulation::getLocalMinimumNextThreadSendTime()
+{
+    SimTime_t ret = MAX_SIMTIME_T;
+    for ( auto && instance : instanceVec ) {
+        SimTime_t next = instance->getNextActivityTime();
+        if ( next >= MAX_SIMTIME_T - instance->threadSendLatency ) continue;
+        next += instance->threadSendLatency;
+        if ( next < ret ) {
+            ret = next;
+        }
+    }
+
+    return ret;
+}
+
+SimTime_t
+Simulation::getLocalMinimumNextRankSendTime()
+{
+    // Threads pass events to each other between rank syncs, so any
+    // thread's next activity can lead to a send on any other thread's
+    // links.
+    SimTime_t latency = MAX_SIMTIME_T;
+    for ( auto && instance : instanceVec ) {
+        if ( instance->rankSendLatency < latency ) {
+            latency = instance->rankSendLatency;
+        }
+    }
+
+    SimTime_t next = getLocalMinimumNextActivityTime();
+    if ( next >= MAX_SIMTIME_T - latency ) return MAX_SIMTIME_T;
+    return next + latency;
+}
+
 void
 Simulation::processGraphInfo( ConfigGraph& graph, const RankInfo& UNUSED(myRank), SimTime_t min_part )
 {
@@ -223,7 +267,7 @@ Simulation::processGraphInfo( ConfigGraph& graph, const RankInfo& UNUSED(myRank)
 
     interThreadMinLatency = MAX_SIMTIME_T;
     int cross_thread_links = 0;
-    if ( num_ranks.thread > 1 ) {
+    if ( num_ranks.thread > 1 || ( adaptiveSync && num_ranks.rank > 1 ) ) {
         // Need to determine the lookahead for the thread synchronization
         ConfigComponentMap_t comps = graph.getComponentMap();
         ConfigLinkMap_t links = graph.getLinkMap();
@@ -240,8 +284,16 @@ Simulation::processGraphInfo( ConfigGraph& graph, const RankInfo& UNUSED(myRank)
             if ( rank[0].rank != my_rank.rank && rank[1].rank != my_rank.rank ) continue;
             // Rank and thread are the same
             if ( rank[0] == rank[1] ) continue;
-            // Different ranks, so doesn't affect interthread dependencies
-            if ( rank[0].rank != rank[1].rank ) continue;
+            // Different ranks, so doesn't affect interthread
+            // dependencies, but bounds when this thread can next
+            // send to another rank
+            if ( rank[0].rank != rank[1].rank ) {
+                if ( ( rank[0] == my_rank || rank[1] == my_rank ) &&
+                     clink.getMinLatency() < rankSendLatency ) {
+                    rankSendLatency = clink.getMinLatency();
+                }
+                continue;
+            }
 
             // At this point, we know that both endpoints are on this
             // rank, but on different threads.  Therefore, they
@@ -265,6 +317,9 @@ Simulation::processGraphInfo( ConfigGraph& graph, const RankInfo& UNUSED(myRank)
                 }
             }
         }
+        for ( auto latency : interThreadLatencies ) {
+            if ( latency < threadSendLatency ) threadSendLatency = latency;
+        }
     }
     // Create the SyncManager for this rank.  It gets created even if
     // we are single rank/single thread because it also manages the
@@ -537,11 +592,38 @@ void Simulation::run() {
     header += ", ";
     header += SST::to_string(my_rank.thread);
     header += ":  ";
+    // Activities are pulled out of the TimeVortex in batches that
+    // share a delivery time and priority
+    std::vector<Activity*> batch;
     while( LIKELY( ! endSim ) ) {
-        currentSimCycle = timeVortex->front()->getDeliveryTime();
-        currentPriority = timeVortex->front()->getPriority();
-        current_activity = timeVortex->pop();
-        current_activity->execute();
+        // Clock ticks are merged in from the ClockScheduler
+        if ( clockScheduler.before(timeVortex->front()) ) {
+            Clock* clock = clockScheduler.pop();
+            currentSimCycle = clock->getDeliveryTime();
+            currentPriority = clock->getPriority();
+            current_activity = clock;
+            current_activity->execute();
+        }
+        else {
+            timeVortex->popBatch(batch);
+            currentSimCycle = batch.front()->getDeliveryTime();
+            currentPriority = batch.front()->getPriority();
+            for ( size_t i = 0; i < batch.size(); i++ ) {
+                current_activity = batch[i];
+                current_activity->execute();
+
+                // If the simulation ended, or something was inserted
+                // that may need to run ahead of the rest of the batch,
+                // return the remainder of the batch to the TimeVortex
+                if ( UNLIKELY( endSim || timeVortex->batchInterrupted() ) ) {
+                    for ( size_t j = i + 1; j < batch.size(); j++ ) {
+                        timeVortex->requeue(batch[j]);
+                    }
+                    break;
+                }
+            }
+            batch.clear();
+        }
 
 
         if ( UNLIKELY( 0 != lastRecvdSignal ) ) {
@@ -602,6 +684,9 @@ void Simulation::endSimulation(SimTime_t end)
     endSimCycle = end;
     endSim = true;
 
+    // Threads that run ahead of each other need to be told this one
+    // will not send anything else
+    if ( syncManager ) syncManager->prepareForExit();
     exitBarrier.wait();
 
 
@@ -639,24 +724,12 @@ void Simulation::finish() {
     }
 }
 
-const SimTime_t&
-Simulation::getCurrentSimCycle() const
-{
-    return currentSimCycle; 
-}
-
 SimTime_t
 Simulation::getEndSimCycle() const
 {
     return endSimCycle; 
 }
 
-int
-Simulation::getCurrentPriority() const
-{
-    return currentPriority; 
-}
-
 
 // void Simulation::getElapsedSimTime(double *value, char *prefix) const
 // {
@@ -699,6 +772,8 @@ void Simulation::printStatus(bool fullStatus)
 
     if ( fullStatus ) {
         timeVortex->print(out);
+        out.output("---- Clocks: ----\n");
+        clockScheduler.print(out);
         out.output("---- Components: ----\n");
         for ( auto iter = compInfoMap.begin(); iter != compInfoMap.end(); ++iter ) {
             (*iter)->getComponent()->printStatus(out);
@@ -840,6 +915,13 @@ void Simulation::resizeBarriers(uint32_t nthr) {
     runBarrier.resize(nthr);
     exitBarrier.resize(nthr);
     finishBarrier.resize(nthr);
+
+    initBarrier.setName("Simulation::init");
+    completeBarrier.setName("Simulation::complete");
+    setupBarrier.setName("Simulation::setup");
+    runBarrier.setName("Simulation::run");
+    exitBarrier.setName("Simulation::exit");
+    finishBarrier.setName("Simulation::finish");
 }
 
 
@@ -861,7 +943,7 @@ SimTime_t Simulation::minPart;
 
 /* Define statics (Simulation) */
 SharedRegionManager* Simulation::sharedRegionManager = new SharedRegionManagerImpl();
-std::unordered_map<std::thread::id, Simulation*> Simulation::instanceMap;
+thread_local Simulation* Simulation::instance = NULL;
 std::vector<Simulation*> Simulation::instanceVec;
 std::atomic<int> Simulation::untimed_msg_count;
 Exit* Simulation::m_exit;
@@ -25,6 +25,7 @@
 
 #include <sst/core/output.h>
 #include <sst/core/clock.h>
+#include <sst/core/clockScheduler.h>
 #include <sst/core/oneshot.h>
 #include <sst/core/unitAlgebra.h>
 #include <sst/core/rankInfo.h>
@@ -96,7 +97,7 @@ public:
      */
     static void shutdown();
     /** Return a pointer to the singleton instance of the Simulation */
-    static Simulation *getSimulation() { return instanceMap.at(std::this_thread::get_id()); }
+    static Simulation *getSimulation() { return instance; }
     /** Sets an internal flag for signaling the simulation.  Used internally */
     static void setSignal(int signal);
     /** Causes the current status of the simulation to be printed to stderr.
@@ -129,11 +130,11 @@ public:
     /** Get the run mode of the simulation (e.g. init, run, both etc) */
     Mode_t getSimulationMode() const { return runMode; };
     /** Return the current simulation time as a cycle count*/
-    const SimTime_t& getCurrentSimCycle() const;
+    const SimTime_t& getCurrentSimCycle() const { return currentSimCycle; }
     /** Return the end simulation time as a cycle count*/
     SimTime_t getEndSimCycle() const;
     /** Return the current priority */
-    int getCurrentPriority() const;
+    int getCurrentPriority() const { return currentPriority; }
     /** Return the elapsed simulation time as a time */
     UnitAlgebra getElapsedSimTime() const;
     /** Return the end simulation time as a time */
@@ -170,6 +171,16 @@ public:
 
     const std::vector<SimTime_t>& getInterThreadLatencies() const { return interThreadLatencies; }
     SimTime_t getInterThreadMinLatency() const { return interThreadMinLatency; }
+    /** Thread synchronization algorithm selected with --thread-sync */
+    const std::string& getThreadSyncMode() const { return threadSyncMode; }
+    /** True if cross-thread events are tagged with their receiving Link when sent */
+    bool getThreadDirectDelivery() const { return threadDirectDelivery; }
+    /** True if syncs are scheduled from each partition's earliest possible send */
+    bool getAdaptiveSync() const { return adaptiveSync; }
+    /** True if rank syncs overlap their exchange with execution */
+    bool getSplitRankSync() const { return splitRankSync; }
+    /** Wire encoding of events sent between ranks, selected with --rank-sync-encoding */
+    const std::string& getRankSyncEncoding() const { return rankSyncEncoding; }
     static TimeConverter* getMinPartTC() { return minPartTC; }
 
     /** Return the TimeLord associated with this Simulation */
@@ -263,6 +274,20 @@ public:
      *  the Rank
      */
     static SimTime_t getLocalMinimumNextActivityTime();
+
+    /**
+     *  Gets the earliest time any thread in the Rank could send an
+     *  event to another thread: each thread's next activity plus the
+     *  smallest latency of its links to other threads
+     */
+    static SimTime_t getLocalMinimumNextThreadSendTime();
+
+    /**
+     *  Gets the earliest time the Rank could send an event to another
+     *  rank: the minimum next activity in the Rank plus the smallest
+     *  latency of its links to other ranks
+     */
+    static SimTime_t getLocalMinimumNextRankSendTime();
     
     /**
      * Returns the Simulation's SharedRegionManager
@@ -277,6 +302,7 @@ public:
 private:
     friend class Link;
     friend class Action;
+    friend class Clock;
     friend class Output;
     // To enable main to set up globals
     friend int ::main(int argc, char **argv);
@@ -314,6 +340,10 @@ private:
 
     TimeVortex* getTimeVortex() const { return timeVortex; }
 
+    /** Schedule a clock to tick at the specified time.  Clocks are
+     * kept out of the TimeVortex. */
+    void insertClock(SimTime_t time, Clock* clock) { clockScheduler.insert(time, clock); }
+
     /** Emergency Shutdown
      * Called when a SIGINT or SIGTERM has been seen
      */
@@ -330,6 +360,8 @@ private:
     } ShutdownMode_t;
 
     friend class SyncManager;
+    friend class NewThreadSync;
+    friend class ThreadSyncOptimistic;
     
     Mode_t   runMode;
     TimeVortex*      timeVortex;
@@ -339,10 +371,18 @@ private:
     static TimeConverter*   minPartTC;
     std::vector<SimTime_t> interThreadLatencies;
     SimTime_t        interThreadMinLatency;
+    SimTime_t        threadSendLatency;
+    SimTime_t        rankSendLatency;
+    std::string      threadSyncMode;
+    bool             threadDirectDelivery;
+    bool             adaptiveSync;
+    bool             splitRankSync;
+    std::string      rankSyncEncoding;
     SyncManager*     syncManager;
     ThreadSync*      threadSync;
     ComponentInfoMap compInfoMap;
     clockMap_t       clockMap;
+    ClockScheduler   clockScheduler;
     oneShotMap_t     oneShotMap;
     SimTime_t        currentSimCycle;
     SimTime_t        endSimCycle;
@@ -361,7 +401,8 @@ private:
     static SharedRegionManager* sharedRegionManager;
     bool             wireUpFinished;
 
-    static std::unordered_map<std::thread::id, Simulation*> instanceMap;
+    /** The Simulation run by this thread, set once in createSimulation() */
+    static thread_local Simulation* instance;
     static std::vector<Simulation*> instanceVec;
 
     friend void wait_my_turn_start();
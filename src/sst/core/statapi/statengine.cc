@@ -156,6 +156,7 @@ void StatisticProcessingEngine::finalizeInitialization()
     bool master = ( Simulation::getSimulation()->getRank().thread == 0 );
     if ( master ) {
         m_barrier.resize(Simulation::getSimulation()->getNumRanks().thread);
+        m_barrier.setName("StatisticProcessingEngine");
     }
     for ( auto & g : m_statGroups ) {
         if ( master ) {
@@ -96,6 +96,9 @@ public:
 
     const std::vector<StatisticOutput*>& getStatOutputs() const { return m_statOutputs; }
 
+    /** True if any enabled statistic has been registered */
+    bool hasStatistics() const { return !m_CompStatMap.empty(); }
+
 private:
     friend class SST::Simulation;
     friend int ::main(int argc, char **argv);
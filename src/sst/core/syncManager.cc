@@ -19,20 +19,19 @@
 #include "sst/core/syncBase.h"
 #include "sst/core/threadSyncQueue.h"
 #include "sst/core/timeConverter.h"
+#include "sst/core/timeVortex.h"
 
 #include "sst/core/rankSyncSerialSkip.h"
+#include "sst/core/rankSyncSplitPhase.h"
+#include "sst/core/rankSyncSharedMem.h"
 #include "sst/core/rankSyncParallelSkip.h"
 #include "sst/core/rankSyncParallelSkip.h"
 #include "sst/core/threadSyncSimpleSkip.h"
-
-#ifdef SST_CONFIG_HAVE_MPI
-DISABLE_WARN_MISSING_OVERRIDE
-#include <mpi.h>
-REENABLE_WARNING
-#define UNUSED_WO_MPI(x) x
-#else
-#define UNUSED_WO_MPI(x) UNUSED(x)
-#endif
+#include "sst/core/threadSyncPairwise.h"
+#include "sst/core/threadSyncNullMessage.h"
+#include "sst/core/threadSyncOptimistic.h"
+#include "sst/core/objectComms.h"
+#include "sst/core/interprocess/rankTunnel.h"
 
 namespace SST {
 
@@ -53,23 +52,17 @@ public:
     ActivityQueue* registerLink(const RankInfo& UNUSED(to_rank), const RankInfo& UNUSED(from_rank), LinkId_t UNUSED(link_id), Link* UNUSED(link)) override { return NULL; }
 
     void execute(int UNUSED(thread)) override {}
-    void exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::atomic<int>& UNUSED_WO_MPI(msg_count)) override {
+    void exchangeLinkUntimedData(int thread, std::atomic<int>& msg_count) override {
         // Even though there are no links crossing ranks, we still
         // need to make sure every rank does the same number of init
         // cycles so the shared memory regions initialization works.
         
-#ifdef SST_CONFIG_HAVE_MPI
         if ( thread != 0 ) {
             return;
         }
         
         // Do an allreduce to see if there were any messages sent
-        int input = msg_count;
-
-        int count;
-        MPI_Allreduce( &input, &count, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD );
-        msg_count = count;
-#endif
+        msg_count = Comms::all_reduce(static_cast<int>(msg_count), Comms::REDUCE_SUM);
     }
     void finalizeLinkConfigurations() override {}
 
@@ -82,6 +75,66 @@ public:
     uint64_t getDataSize() const override { return 0; }
 };
 
+NewThreadSync::~NewThreadSync()
+{
+    for ( auto& q : direct_queues ) {
+        delete q.second;
+    }
+}
+
+ActivityQueue*
+NewThreadSync::getQueueForLink(int tid, LinkId_t link_id)
+{
+    if ( !direct_delivery ) return getQueueForThread(tid);
+    ThreadSyncDirectQueue* queue = new ThreadSyncDirectQueue(getQueueForThread(tid));
+    direct_queues[link_id] = queue;
+    return queue;
+}
+
+void
+NewThreadSync::resolveDirectQueues(const std::unordered_map<LinkId_t, Link*>& link_map)
+{
+    for ( auto& q : direct_queues ) {
+        auto link = link_map.find(q.first);
+        if ( link == link_map.end() ) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+        }
+        q.second->setTarget(link->second->pair_link);
+    }
+}
+
+void
+NewThreadSync::deliverDirect(std::vector<Activity*>& vec, std::vector<Activity*>& tv_batch)
+{
+    ActivityQueue* tv = Simulation::getSimulation()->timeVortex;
+    for ( size_t i = 0; i < vec.size(); i++ ) {
+        ActivityQueue* queue = static_cast<Event*>(vec[i])->getDeliveryLink()->recvQueue;
+        if ( queue == tv ) tv_batch.push_back(vec[i]);
+        else queue->insert(vec[i]);
+    }
+    vec.clear();
+}
+
+SimTime_t
+NewThreadSync::getNextActivityTime()
+{
+    Simulation* sim = Simulation::getSimulation();
+    SimTime_t next = sim->clockScheduler.getNextTime();
+    if ( !sim->timeVortex->empty() ) {
+        SimTime_t tv_next = sim->timeVortex->front()->getDeliveryTime();
+        if ( tv_next < next ) next = tv_next;
+    }
+    return next;
+}
+
+void
+NewThreadSync::flushDirect(std::vector<Activity*>& tv_batch)
+{
+    if ( tv_batch.empty() ) return;
+    Simulation::getSimulation()->timeVortex->insertBatch(tv_batch);
+    tv_batch.clear();
+}
+
 class EmptyThreadSync : public NewThreadSync {
 public:
     EmptyThreadSync () {
@@ -115,8 +168,20 @@ SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, TimeCo
     if ( rank.thread == 0  ) {
         for ( auto &b : RankExecBarrier ) { b.resize(num_ranks.thread); }
         for ( auto &b : LinkUntimedBarrier ) { b.resize(num_ranks.thread); }
+        for ( size_t i = 0; i < 6; i++ ) {
+            RankExecBarrier[i].setName("SyncManager::RankExec[" + std::to_string(i) + "]");
+        }
+        for ( size_t i = 0; i < 3; i++ ) {
+            LinkUntimedBarrier[i].setName("SyncManager::LinkUntimed[" + std::to_string(i) + "]");
+        }
         if ( min_part != MAX_SIMTIME_T ) {
-            if ( num_ranks.thread == 1 ) {
+            if ( Core::Interprocess::RankTunnel::get() ) {
+                rankSync = new RankSyncSharedMem(num_ranks, minPartTC);
+            }
+            else if ( sim->getSplitRankSync() ) {
+                rankSync = new RankSyncSplitPhase(num_ranks, minPartTC);
+            }
+            else if ( num_ranks.thread == 1 ) {
                 rankSync = new RankSyncSerialSkip(/*num_ranks,*/ minPartTC);
             }
             else {
@@ -133,7 +198,21 @@ SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, TimeCo
     // of the active threadsyncs.
     SimTime_t interthread_minlat = sim->getInterThreadMinLatency();
     if ( num_ranks.thread > 1 && interthread_minlat != MAX_SIMTIME_T ) {
-        threadSync = new ThreadSyncSimpleSkip(num_ranks.thread, rank.thread, Simulation::getSimulation());
+        if ( sim->getThreadSyncMode() == "pairwise" ) {
+            threadSync = new ThreadSyncPairwise(num_ranks.thread, rank.thread, sim, min_part == MAX_SIMTIME_T);
+        }
+        else if ( sim->getThreadSyncMode() == "cmb" ) {
+            threadSync = new ThreadSyncNullMessage(num_ranks.thread, rank.thread, sim, min_part == MAX_SIMTIME_T);
+        }
+        else if ( sim->getThreadSyncMode() == "optimistic" && min_part == MAX_SIMTIME_T ) {
+            threadSync = new ThreadSyncOptimistic(num_ranks.thread, rank.thread, sim);
+        }
+        else {
+            if ( sim->getThreadSyncMode() == "optimistic" && rank.thread == 0 && rank.rank == 0 ) {
+                sim->getSimulationOutput().output("WARNING: optimistic thread sync only runs on a single rank, using simple\n");
+            }
+            threadSync = new ThreadSyncSimpleSkip(num_ranks.thread, rank.thread, sim);
+        }
     }
     else {
         threadSync = new EmptyThreadSync();
@@ -165,7 +244,8 @@ SyncManager::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, Li
 
         // Need to get target queue from the remote ThreadSync
         NewThreadSync* remoteSync = Simulation::instanceVec[to_rank.thread]->syncManager->threadSync;
-        return remoteSync->getQueueForThread(from_rank.thread);
+        threadSync->registerRemoteQueue(to_rank.thread, remoteSync->getQueueForThread(from_rank.thread));
+        return remoteSync->getQueueForLink(from_rank.thread, link_id);
     }
     else {
         // Different rank.  Send info onto the RankSync
@@ -204,7 +284,7 @@ SyncManager::execute(void)
 
         RankExecBarrier[3].wait();
         
-        if ( exit != NULL && rank.thread == 0 ) exit->check();
+        if ( exit != NULL && rank.thread == 0 && !rankSync->checksExit() ) exit->check();
 
         RankExecBarrier[4].wait();
 
@@ -216,7 +296,15 @@ SyncManager::execute(void)
     case THREAD:
 
         threadSync->execute();
-        
+
+        // Pairwise syncs only involve some of the threads, so the
+        // exit check and the closing barrier have to wait for a sync
+        // that includes everyone.
+        if ( !threadSync->isGlobalSync() ) {
+            computeNextInsert();
+            return;
+        }
+
         if ( /*num_ranks.rank == 1*/ min_part == MAX_SIMTIME_T ) {
             if ( exit->getRefCount() == 0 ) {
                 endSimulation(exit->getEndTime());
@@ -228,6 +316,10 @@ SyncManager::execute(void)
         break;
     }
     computeNextInsert();
+#ifdef USE_MEMPOOL
+    // Take back the events other threads have freed since the last sync
+    Activity::drainRemoteFrees();
+#endif
     RankExecBarrier[5].wait();
 }
 
@@ -268,6 +360,7 @@ SyncManager::prepareForComplete()
 void
 SyncManager::computeNextInsert()
 {
+    threadSync->setNextRankSyncTime(rankSync->getNextSyncTime());
     if ( rankSync->getNextSyncTime() <= threadSync->getNextSyncTime() ) {
         next_sync_type = RANK;
         sim->insertActivity(rankSync->getNextSyncTime(), this);
@@ -27,6 +27,7 @@ namespace SST {
 class Exit;
 class Simulation;
 class SyncBase;
+class ThreadSyncDirectQueue;
 class ThreadSyncQueue;
 class TimeConverter;
 
@@ -45,6 +46,10 @@ public:
 
     virtual SimTime_t getNextSyncTime() { return nextSyncTime; }
 
+    /** True if execute() also checks for exit, so the SyncManager
+     * does not need to call Exit::check() */
+    virtual bool checksExit() { return false; }
+
     // void setMaxPeriod(TimeConverter* period) {max_period = period;}
     TimeConverter* getMaxPeriod() {return max_period;}
 
@@ -52,6 +57,7 @@ public:
     
 protected:
     SimTime_t nextSyncTime;
+    SimTime_t next_rank_sync;
     TimeConverter* max_period; 
 
     void finalizeConfiguration(Link* link) {
@@ -72,8 +78,8 @@ private:
 
 class NewThreadSync {
 public:
-    NewThreadSync () {}
-    virtual ~NewThreadSync() {}
+    NewThreadSync () : next_rank_sync(MAX_SIMTIME_T), direct_delivery(false) {}
+    virtual ~NewThreadSync();
 
     virtual void before() = 0;
     virtual void after() = 0;
@@ -84,16 +90,47 @@ public:
 
     virtual SimTime_t getNextSyncTime() { return nextSyncTime; }
 
+    /** True if the last execute() synchronized every thread on the
+     * rank, which is required before checking for exit */
+    virtual bool isGlobalSync() { return true; }
+
+    /** Called when this thread is about to stop for good, before it
+     * blocks in the collective end of simulation */
+    virtual void prepareForExit() {}
+
+    /** Called by the SyncManager with the time of the next rank sync */
+    void setNextRankSyncTime(SimTime_t time) { next_rank_sync = time; }
+
     void setMaxPeriod(TimeConverter* period) {max_period = period;}
     TimeConverter* getMaxPeriod() {return max_period;}
 
     /** Register a Link which this Sync Object is responsible for */
     virtual void registerLink(LinkId_t link_id, Link* link) = 0;
+    /** Called with the queue on thread tid that this thread's links send into */
+    virtual void registerRemoteQueue(int UNUSED(tid), ActivityQueue* UNUSED(queue)) {}
     virtual ActivityQueue* getQueueForThread(int tid) = 0;
+    /** Queue thread tid sends into for link_id.  With direct delivery
+     * each link gets its own queue, so the sending thread can tag
+     * events with the Link that receives them. */
+    ActivityQueue* getQueueForLink(int tid, LinkId_t link_id);
     
 protected:
     SimTime_t nextSyncTime;
+    SimTime_t next_rank_sync;
     TimeConverter* max_period;
+    bool direct_delivery;
+    std::unordered_map<LinkId_t, ThreadSyncDirectQueue*> direct_queues;
+
+    /** Point each direct queue at the Link its events are received on */
+    void resolveDirectQueues(const std::unordered_map<LinkId_t, Link*>& link_map);
+    /** Move events tagged on the sending thread into their receiving
+     * queues.  Events for the TimeVortex are appended to tv_batch so
+     * they can be inserted together by flushDirect(). */
+    void deliverDirect(std::vector<Activity*>& vec, std::vector<Activity*>& tv_batch);
+    void flushDirect(std::vector<Activity*>& tv_batch);
+    /** Earliest time of anything scheduled on this thread, either in
+     * the TimeVortex or on a clock */
+    SimTime_t getNextActivityTime();
     
     void finalizeConfiguration(Link* link) {
         link->finalizeConfiguration();
@@ -124,6 +161,8 @@ public:
     /** Finish link configuration */
     void finalizeLinkConfigurations();
     void prepareForComplete();
+    /** Called when this thread is about to end the simulation */
+    void prepareForExit() { threadSync->prepareForExit(); }
 
     void print(const std::string& header, Output &out) const override;
 
@@ -18,19 +18,89 @@
 
 #include <sst/core/simulation.h>
 
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
 
 namespace SST {
 
 using namespace Core::ThreadSafe;
 using namespace Core::Serialization;
 
+// Layout of the fields the serializer writes at the start of every
+// event: the class id, then Activity's queue_order, delivery_time and
+// priority, then either the Event's link_id or, with
+// SST_ENFORCE_EVENT_ORDERING, Activity's enforce_link_order
+static_assert(sizeof(LinkId_t) == sizeof(int32_t), "LinkId_t must match the 32-bit link field in the compact encoding");
+static const size_t event_prefix_size = sizeof(long) + sizeof(uint64_t) + sizeof(SimTime_t) + sizeof(int) + sizeof(int32_t);
+
+static inline void
+putVarint(std::vector<char>& out, uint64_t value)
+{
+    while ( value >= 0x80 ) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+static inline uint64_t
+getVarint(const char*& ptr, const char* end)
+{
+    uint64_t value = 0;
+    for ( int shift = 0; shift < 64; shift += 7 ) {
+        if ( ptr == end ) break;
+        uint8_t byte = static_cast<uint8_t>(*ptr++);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ( !(byte & 0x80) ) return value;
+    }
+    Simulation::getSimulationOutput().fatal(CALL_INFO, 1, "Corrupt compact SyncQueue data\n");
+    return 0;
+}
+
+static inline uint64_t
+zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static inline int64_t
+unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+template <typename T>
+static inline T
+takeField(const char*& ptr)
+{
+    T value;
+    ::memcpy(&value, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return value;
+}
+
+template <typename T>
+static inline void
+putField(std::vector<char>& out, T value)
+{
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
 SyncQueue::SyncQueue() :
     ActivityQueue(), buffer(NULL), buf_size(0)
 {
+    const std::string& mode = Simulation::getSimulation()->getRankSyncEncoding();
+    if ( mode == "compressed" ) encoding = COMPRESSED;
+    else if ( mode == "compact" ) encoding = COMPACT;
+    else encoding = RAW;
 }
 
 SyncQueue::~SyncQueue()
 {
+    delete[] buffer;
 }
     
 bool
@@ -80,42 +150,223 @@ SyncQueue::clear()
     activities.clear();
 }
 
+void
+SyncQueue::grow(size_t used)
+{
+    size_t new_size = buf_size * 2;
+    if ( new_size < 4096 ) new_size = 4096;
+    char* new_buffer = new char[new_size];
+    if ( used > 0 ) ::memcpy(new_buffer, buffer, used);
+    delete[] buffer;
+    buffer = new_buffer;
+    buf_size = new_size;
+}
+
 char*
 SyncQueue::getData()
 {
     std::lock_guard<Spinlock> lock(slock);
 
-    serializer ser;
+    if ( encoding != RAW ) return getEncodedData();
 
-    ser.start_sizing();
-
-    ser & activities;
+    // Pack in a single pass, in the same format as ser & activities.
+    // The buffer is kept from one sync to the next and only grows, by
+    // doubling, when an activity does not fit.
+    if ( buffer == NULL ) grow(0);
+    size_t offset = sizeof(SyncQueue::Header);
 
-    size_t size = ser.size();
+    serializer ser;
+    size_t count = activities.size();
+    while ( buf_size - offset < sizeof(count) ) grow(offset);
+    ser.start_packing(buffer + offset, buf_size - offset);
+    ser & count;
+    offset += ser.packer().size();
 
-    if ( buf_size < ( size + sizeof(SyncQueue::Header) ) ) {
-        if ( buffer != NULL ) {
-            delete[] buffer;
+    for ( size_t i = 0; i < count; i++ ) {
+        while ( true ) {
+            ser.start_packing(buffer + offset, buf_size - offset);
+            try {
+                ser & activities[i];
+                break;
+            }
+            catch ( pvt::ser_buffer_overrun& ) {
+                grow(offset);
+            }
         }
-        
-        buf_size = size + sizeof(SyncQueue::Header);
-        buffer = new char[buf_size];
-    }
-        
-    ser.start_packing(buffer + sizeof(SyncQueue::Header), size);
-
-    ser & activities;
-
-    // Delete all the events
-    for ( unsigned int i = 0; i < activities.size(); i++ ) {
+        offset += ser.packer().size();
         delete activities[i];
     }
     activities.clear();
 
     // Set the size field in the header
-    static_cast<SyncQueue::Header*>(static_cast<void*>(buffer))->buffer_size = size + sizeof(SyncQueue::Header);
+    SyncQueue::Header* hdr = static_cast<SyncQueue::Header*>(static_cast<void*>(buffer));
+    hdr->buffer_size = offset;
+    hdr->encoding = RAW;
     
     return buffer;
 }
 
+char*
+SyncQueue::getEncodedData()
+{
+    // Each event is serialized on its own into buffer, then its fixed
+    // fields are rewritten into wire and the rest copied after them
+    if ( buffer == NULL ) grow(0);
+    wire.clear();
+    wire.resize(sizeof(SyncQueue::Header));
+    putVarint(wire, activities.size());
+
+    serializer ser;
+    std::vector<long> classes;
+    SimTime_t last_time = 0;
+    for ( size_t i = 0; i < activities.size(); i++ ) {
+        while ( true ) {
+            ser.start_packing(buffer, buf_size);
+            try {
+                ser & activities[i];
+                break;
+            }
+            catch ( pvt::ser_buffer_overrun& ) {
+                grow(0);
+            }
+        }
+        delete activities[i];
+
+        size_t size = ser.packer().size();
+        if ( size < event_prefix_size ) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO, 1, "Serialized event is smaller than the Event fields\n");
+        }
+        const char* ptr = buffer;
+        long cls_id = takeField<long>(ptr);
+        uint64_t queue_order = takeField<uint64_t>(ptr);
+        SimTime_t delivery_time = takeField<SimTime_t>(ptr);
+        int priority = takeField<int>(ptr);
+        int32_t link = takeField<int32_t>(ptr);
+
+        size_t index = 0;
+        while ( index < classes.size() && classes[index] != cls_id ) index++;
+        putVarint(wire, index);
+        if ( index == classes.size() ) {
+            classes.push_back(cls_id);
+            putVarint(wire, zigzag(cls_id));
+        }
+        putVarint(wire, zigzag(static_cast<int64_t>(delivery_time - last_time)));
+        last_time = delivery_time;
+        putVarint(wire, zigzag(priority));
+        putVarint(wire, queue_order);
+        putVarint(wire, zigzag(link));
+        putVarint(wire, size - event_prefix_size);
+        wire.insert(wire.end(), ptr, static_cast<const char*>(buffer) + size);
+    }
+    activities.clear();
+
+#ifdef HAVE_LIBZ
+    size_t data_size = wire.size() - sizeof(SyncQueue::Header);
+    if ( encoding == COMPRESSED && data_size > compress_threshold ) {
+        uLongf compressed_size = compressBound(data_size);
+        scratch.resize(sizeof(SyncQueue::Header) + sizeof(uint32_t) + compressed_size);
+        Bytef* dest = reinterpret_cast<Bytef*>(scratch.data() + sizeof(SyncQueue::Header) + sizeof(uint32_t));
+        const Bytef* src = reinterpret_cast<const Bytef*>(wire.data() + sizeof(SyncQueue::Header));
+        if ( compress2(dest, &compressed_size, src, data_size, Z_BEST_SPEED) == Z_OK && compressed_size < data_size ) {
+            uint32_t uncompressed_size = data_size;
+            ::memcpy(scratch.data() + sizeof(SyncQueue::Header), &uncompressed_size, sizeof(uint32_t));
+            scratch.resize(sizeof(SyncQueue::Header) + sizeof(uint32_t) + compressed_size);
+            SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(scratch.data());
+            hdr->buffer_size = scratch.size();
+            hdr->encoding = COMPRESSED;
+            return scratch.data();
+        }
+    }
+#endif
+
+    SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(wire.data());
+    hdr->buffer_size = wire.size();
+    hdr->encoding = COMPACT;
+    return wire.data();
+}
+
+uint32_t
+SyncQueue::growReceiveSize(uint32_t current, uint32_t needed)
+{
+    uint64_t size = current < 4096 ? 4096 : current;
+    while ( size < needed ) size *= 2;
+    return size > UINT32_MAX ? needed : static_cast<uint32_t>(size);
+}
+
+void
+SyncQueue::unpack(char* buffer, std::vector<Activity*>& activities)
+{
+    SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
+    char* data = buffer + sizeof(SyncQueue::Header);
+    size_t size = hdr->buffer_size - sizeof(SyncQueue::Header);
+
+    serializer ser;
+    if ( hdr->encoding == RAW ) {
+        ser.start_unpacking(data, size);
+        ser & activities;
+        return;
+    }
+
+    // Kept per thread, since every thread deserializes with
+    // RankSyncParallelSkip
+    static thread_local std::vector<char> compact;
+    static thread_local std::vector<char> raw;
+
+    if ( hdr->encoding == COMPRESSED ) {
+#ifdef HAVE_LIBZ
+        uint32_t uncompressed_size;
+        ::memcpy(&uncompressed_size, data, sizeof(uint32_t));
+        compact.resize(uncompressed_size);
+        uLongf dest_size = uncompressed_size;
+        const Bytef* src = reinterpret_cast<const Bytef*>(data + sizeof(uint32_t));
+        if ( uncompress(reinterpret_cast<Bytef*>(compact.data()), &dest_size, src, size - sizeof(uint32_t)) != Z_OK ||
+             dest_size != uncompressed_size ) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO, 1, "Corrupt compressed SyncQueue data\n");
+        }
+        data = compact.data();
+        size = uncompressed_size;
+#else
+        Simulation::getSimulationOutput().fatal(CALL_INFO, 1, "Received compressed SyncQueue data, but SST was built without libz\n");
+#endif
+    }
+
+    // Rebuild what the serializer wrote, then deserialize as usual
+    const char* ptr = data;
+    const char* end = data + size;
+    size_t count = getVarint(ptr, end);
+    raw.clear();
+    putField(raw, count);
+
+    std::vector<long> classes;
+    SimTime_t last_time = 0;
+    for ( size_t i = 0; i < count; i++ ) {
+        size_t index = getVarint(ptr, end);
+        if ( index == classes.size() ) {
+            classes.push_back(static_cast<long>(unzigzag(getVarint(ptr, end))));
+        }
+        else if ( index > classes.size() ) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO, 1, "Corrupt compact SyncQueue data\n");
+        }
+        last_time += unzigzag(getVarint(ptr, end));
+        int priority = static_cast<int>(unzigzag(getVarint(ptr, end)));
+        uint64_t queue_order = getVarint(ptr, end);
+        int32_t link = static_cast<int32_t>(unzigzag(getVarint(ptr, end)));
+        size_t rest = getVarint(ptr, end);
+        if ( rest > static_cast<size_t>(end - ptr) ) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO, 1, "Corrupt compact SyncQueue data\n");
+        }
+
+        putField(raw, classes[index]);
+        putField(raw, queue_order);
+        putField(raw, last_time);
+        putField(raw, priority);
+        putField(raw, link);
+        raw.insert(raw.end(), ptr, ptr + rest);
+        ptr += rest;
+    }
+
+    ser.start_unpacking(raw.data(), raw.size());
+    ser & activities;
+}
+
 } // namespace SST
@@ -35,8 +35,27 @@ public:
         uint32_t mode;
         uint32_t count;
         uint32_t buffer_size;
+        /** How the data after the header is encoded */
+        uint32_t encoding;
     };
-    
+
+    /** Wire encodings for the data after the header, selected with
+     * --rank-sync-encoding */
+    enum Encoding {
+        /** The events as written by the serializer */
+        RAW = 0,
+        /** Delivery times as deltas, and the fixed Activity and Event
+         * fields and class ids as varints, with the class ids
+         * replaced by an index into a dictionary built as the batch
+         * is written */
+        COMPACT = 1,
+        /** COMPACT, then compressed with zlib when over
+         * compress_threshold bytes */
+        COMPRESSED = 2
+    };
+
+    enum { compress_threshold = 4096 };
+
     SyncQueue();
     ~SyncQueue();
 
@@ -52,11 +71,33 @@ public:
     /** Accessor method to the internal queue */
     char* getData();
 
+    /** Deserialize a buffer returned by getData() on another rank,
+     * in any encoding, replacing the contents of activities with its
+     * events */
+    static void unpack(char* buffer, std::vector<Activity*>& activities);
+
+    /** Size to grow a receive buffer of current bytes to when a sync
+     * needs at least needed bytes.  Both ends of an exchange apply
+     * this, so the sender knows the new size without being told, and
+     * growing geometrically keeps the resize handshake rare. */
+    static uint32_t growReceiveSize(uint32_t current, uint32_t needed);
+
     uint64_t getDataSize() {
-        return buf_size + (activities.capacity() * sizeof(Activity*));
+        return buf_size + wire.capacity() + scratch.capacity() + (activities.capacity() * sizeof(Activity*));
     }
     
 private:
+    /** Double the buffer, keeping the first used bytes */
+    void grow(size_t used);
+    /** getData() for the COMPACT and COMPRESSED encodings */
+    char* getEncodedData();
+
+    Encoding encoding;
+    /** Encoded data, with the header */
+    std::vector<char> wire;
+    /** Compressed data, with the header */
+    std::vector<char> scratch;
+
     char* buffer;
     size_t buf_size;
     std::vector<Activity*> activities;
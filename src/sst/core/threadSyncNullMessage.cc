@@ -0,0 +1,351 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/threadSyncNullMessage.h"
+
+#include <time.h>
+
+#include "sst/core/event.h"
+#include "sst/core/link.h"
+#include "sst/core/profile.h"
+#include "sst/core/simulation.h"
+
+namespace SST {
+
+Core::ThreadSafe::Barrier ThreadSyncNullMessage::barrier;
+
+static inline SimTime_t
+addLatency(SimTime_t time, SimTime_t latency)
+{
+    if ( time >= MAX_SIMTIME_T - latency ) return MAX_SIMTIME_T;
+    return time + latency;
+}
+
+void
+ThreadSyncNullMessage::Channel::publish(SimTime_t promise)
+{
+    if ( !pending.empty() ) {
+        lock.lock();
+        if ( published.empty() ) {
+            published.swap(pending);
+        }
+        else {
+            published.insert(published.end(), pending.begin(), pending.end());
+            pending.clear();
+        }
+        seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        lock.unlock();
+    }
+    if ( promise > clock.load(std::memory_order_relaxed) ) {
+        clock.store(promise, std::memory_order_release);
+    }
+}
+
+void
+ThreadSyncNullMessage::Channel::take(std::vector<Activity*>& vec)
+{
+    lock.lock();
+    if ( vec.empty() ) {
+        vec.swap(published);
+    }
+    else {
+        vec.insert(vec.end(), published.begin(), published.end());
+        published.clear();
+    }
+    lock.unlock();
+}
+
+/** Create a new ThreadSyncNullMessage object */
+ThreadSyncNullMessage::ThreadSyncNullMessage(int num_threads, int thread, Simulation* sim, bool check_exit) :
+    NewThreadSync(),
+    num_threads(num_threads),
+    thread(thread),
+    sim(sim),
+    global_sync(false),
+    totalWaitTime(0.0)
+{
+    for ( int i = 0; i < num_threads; i++ ) {
+        queues.push_back(new Channel());
+    }
+
+    if ( thread == 0 ) {
+        barrier.resize(num_threads);
+        barrier.setName("ThreadSyncNullMessage");
+    }
+
+    // Every thread starts at time 0, so each channel is already good
+    // up to its latency.
+    const std::vector<SimTime_t>& latencies = sim->getInterThreadLatencies();
+    for ( int i = 0; i < num_threads; i++ ) {
+        if ( i == thread || latencies[i] == MAX_SIMTIME_T ) continue;
+        Partner p;
+        p.thread = i;
+        p.latency = latencies[i];
+        p.known = latencies[i];
+        p.promised = latencies[i];
+        p.last_seq = 0;
+        p.in = queues[i];
+        p.out = NULL;
+        partners.push_back(p);
+    }
+
+    // Same exit cadence as ThreadSyncPairwise
+    if ( check_exit ) {
+        global_period = sim->getInterThreadMinLatency() * num_threads;
+    }
+    else {
+        global_period = MAX_SIMTIME_T;
+    }
+    next_global = global_period;
+
+    direct_delivery = sim->getThreadDirectDelivery();
+    computeNextSyncTime();
+}
+
+ThreadSyncNullMessage::~ThreadSyncNullMessage()
+{
+    if ( totalWaitTime > 0.0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncNullMessage total wait time: %lg seconds.\n", totalWaitTime);
+    for ( int i = 0; i < num_threads; i++ ) {
+        delete queues[i];
+    }
+    queues.clear();
+}
+
+void
+ThreadSyncNullMessage::registerLink(LinkId_t link_id, Link* link)
+{
+    link_map[link_id] = link;
+}
+
+void
+ThreadSyncNullMessage::registerRemoteQueue(int tid, ActivityQueue* queue)
+{
+    for ( auto& p : partners ) {
+        if ( p.thread == tid ) {
+            p.out = static_cast<Channel*>(queue);
+            return;
+        }
+    }
+}
+
+ActivityQueue*
+ThreadSyncNullMessage::getQueueForThread(int tid)
+{
+    return queues[tid];
+}
+
+void
+ThreadSyncNullMessage::deliver(std::vector<Activity*>& vec)
+{
+    if ( direct_delivery ) {
+        deliverDirect(vec, tv_batch);
+        flushDirect(tv_batch);
+        return;
+    }
+    for ( size_t j = 0; j < vec.size(); j++ ) {
+        Event* ev = static_cast<Event*>(vec[j]);
+        auto link = link_map.find(ev->getLinkId());
+        if (link == link_map.end()) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+        } else {
+            SimTime_t delay = ev->getDeliveryTime() - sim->getCurrentSimCycle();
+            link->second->send(delay,ev);
+        }
+    }
+    vec.clear();
+}
+
+bool
+ThreadSyncNullMessage::receive()
+{
+    bool moved = false;
+    for ( auto& p : partners ) {
+        // Clock first: any events it covers are published by then
+        SimTime_t clock = p.in->clock.load(std::memory_order_acquire);
+        if ( clock > p.known ) {
+            p.known = clock;
+            moved = true;
+        }
+        uint64_t seq = p.in->seq.load(std::memory_order_acquire);
+        if ( seq != p.last_seq ) {
+            p.last_seq = seq;
+            p.in->take(incoming);
+        }
+    }
+    if ( !incoming.empty() ) deliver(incoming);
+    return moved;
+}
+
+void
+ThreadSyncNullMessage::send()
+{
+    // Nothing this thread does from here on can happen before its
+    // next scheduled activity, an event still to arrive from another
+    // thread, or the next rank sync.
+    SimTime_t earliest = getNextActivityTime();
+    if ( next_rank_sync < earliest ) earliest = next_rank_sync;
+    for ( auto& p : partners ) {
+        if ( p.known < earliest ) earliest = p.known;
+    }
+
+    for ( auto& p : partners ) {
+        SimTime_t promise = addLatency(earliest, p.latency);
+        if ( promise > p.promised || !p.out->pending.empty() ) {
+            if ( promise > p.promised ) p.promised = promise;
+            p.out->publish(p.promised);
+        }
+    }
+}
+
+void
+ThreadSyncNullMessage::before()
+{
+    // Called with every thread stopped for a rank sync, so the
+    // senders' pending events can be taken as well.
+    for ( auto& p : partners ) {
+        p.in->take(incoming);
+        p.last_seq = p.in->seq.load(std::memory_order_relaxed);
+        incoming.insert(incoming.end(), p.in->pending.begin(), p.in->pending.end());
+        p.in->pending.clear();
+    }
+    if ( !incoming.empty() ) deliver(incoming);
+}
+
+void
+ThreadSyncNullMessage::after()
+{
+    // Every thread is at the rank sync time with nothing in flight,
+    // so each channel is good up to one latency past it.
+    SimTime_t now = sim->getCurrentSimCycle();
+    for ( auto& p : partners ) {
+        SimTime_t clock = addLatency(now, p.latency);
+        if ( clock > p.known ) p.known = clock;
+        if ( clock > p.promised ) p.promised = clock;
+    }
+    if ( next_global <= now ) next_global = (now / global_period + 1) * global_period;
+    computeNextSyncTime();
+}
+
+void
+ThreadSyncNullMessage::execute()
+{
+    SimTime_t now = sim->getCurrentSimCycle();
+
+    receive();
+    send();
+
+    global_sync = ( now == next_global );
+    if ( global_sync ) {
+        // Clocks were published above, so no one is left waiting on
+        // a thread that is sitting in the barrier
+        totalWaitTime += barrier.wait();
+        next_global += global_period;
+    }
+
+    computeNextSyncTime();
+    if ( nextSyncTime > now ) return;
+
+    // Some channel is only good up to now; wait for it to move.
+    // Each clock that moves may let this thread promise more, which
+    // is passed on right away.
+    // Poll for as long as the barriers do before giving up the core
+    auto startTime = SST::Core::Profile::now();
+    uint32_t budget = Core::ThreadSafe::Barrier::getSpinBudget();
+    uint32_t count = 0;
+    do {
+        count++;
+        if ( count < budget ) {
+#if ( defined( __amd64 ) || defined( __amd64__ ) || \
+        defined( __x86_64 ) || defined( __x86_64__ ) )
+            _mm_pause();
+#elif defined(__PPC64__)
+            asm volatile( "or 27, 27, 27" ::: "memory" );
+#endif
+        } else if ( count < budget + (1024*1024) ) {
+            std::this_thread::yield();
+        } else {
+            struct timespec ts;
+            ts.tv_sec = 0;
+            ts.tv_nsec = 1000;
+            nanosleep(&ts, NULL);
+        }
+        if ( receive() ) {
+            send();
+            computeNextSyncTime();
+        }
+    } while ( nextSyncTime <= now );
+    totalWaitTime += SST::Core::Profile::getElapsed(startTime);
+}
+
+void
+ThreadSyncNullMessage::prepareForExit()
+{
+    // Partners may still be behind this thread and waiting on its
+    // clock; let them run to wherever they stop.
+    for ( auto& p : partners ) {
+        p.promised = MAX_SIMTIME_T;
+        p.out->publish(MAX_SIMTIME_T);
+    }
+}
+
+void
+ThreadSyncNullMessage::computeNextSyncTime()
+{
+    nextSyncTime = next_global;
+    for ( auto& p : partners ) {
+        if ( p.known < nextSyncTime ) nextSyncTime = p.known;
+    }
+}
+
+void
+ThreadSyncNullMessage::processLinkUntimedData()
+{
+    // Need to walk through all the queues and send the data to the
+    // correct links
+    for ( int i = 0; i < num_threads; i++ ) {
+        for ( auto vec : { &queues[i]->pending, &queues[i]->published } ) {
+            for ( size_t j = 0; j < vec->size(); j++ ) {
+                Event* ev = static_cast<Event*>((*vec)[j]);
+                auto link = link_map.find(ev->getLinkId());
+                if (link == link_map.end()) {
+                    Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+                } else {
+                    sendUntimedData_sync(link->second,ev);
+                }
+            }
+            vec->clear();
+        }
+    }
+}
+
+void
+ThreadSyncNullMessage::finalizeLinkConfigurations() {
+    if ( direct_delivery ) resolveDirectQueues(link_map);
+    for ( auto& p : partners ) {
+        if ( p.out == NULL ) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Thread %d has no link queue on partner thread %d\n", thread, p.thread);
+        }
+    }
+    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
+        finalizeConfiguration(i->second);
+    }
+}
+
+void
+ThreadSyncNullMessage::prepareForComplete() {
+    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
+        prepareForCompleteInt(i->second);
+    }
+}
+
+} // namespace SST
@@ -0,0 +1,137 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_THREADSYNCNULLMESSAGE_H
+#define SST_CORE_THREADSYNCNULLMESSAGE_H
+
+#include "sst/core/sst_types.h"
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+#include "sst/core/activityQueue.h"
+#include "sst/core/syncManager.h"
+#include "sst/core/threadsafe.h"
+
+namespace SST {
+
+class Link;
+class Simulation;
+
+/**
+ * Conservative (Chandy-Misra-Bryant) thread synchronization.  Each
+ * thread publishes a clock on every channel to a linked thread: a
+ * promise that it will send nothing on that channel that arrives
+ * before the clock.  A thread runs freely up to the smallest clock of
+ * its incoming channels and only waits when it reaches it.  The
+ * promise is the earliest thing this thread could still do, plus the
+ * link latency to the partner, so a thread that has nothing scheduled
+ * lets its partners run well ahead.  As with ThreadSyncPairwise, a
+ * rank-wide barrier is still needed every so often to check for
+ * exit, since endSimulation() is collective.
+ */
+class ThreadSyncNullMessage : public NewThreadSync {
+public:
+    /** Create a new ThreadSync object.  check_exit is true when no
+     * rank sync will run, so this sync has to make room for the exit
+     * check. */
+    ThreadSyncNullMessage(int num_threads, int thread, Simulation* sim, bool check_exit);
+    ~ThreadSyncNullMessage();
+
+    void before() override;
+    void after() override;
+    void execute(void) override;
+    bool isGlobalSync() override { return global_sync; }
+    void prepareForExit() override;
+
+    /** Cause an exchange of Untimed Data to occur */
+    void processLinkUntimedData() override;
+    /** Finish link configuration */
+    void finalizeLinkConfigurations() override;
+    void prepareForComplete() override;
+
+    /** Register a Link which this Sync Object is responsible for */
+    void registerLink(LinkId_t link_id, Link* link) override;
+    void registerRemoteQueue(int tid, ActivityQueue* queue) override;
+    ActivityQueue* getQueueForThread(int tid) override;
+
+private:
+    /**
+     * Events and the clock sent to this thread by one other thread.
+     * The sender collects events in pending while it runs and moves
+     * them to published, under the lock, when it next syncs.  The
+     * clock is stored after the events it covers, so a receiver that
+     * sees a clock also sees every event sent before it.
+     */
+    class Channel : public ActivityQueue {
+    public:
+        Channel() : ActivityQueue(), clock(0), seq(0) {}
+        ~Channel() {}
+
+        bool empty() override { return pending.empty() && published.empty(); }
+        int size() override { return pending.size() + published.size(); }
+        Activity* pop() override { return NULL; }
+        Activity* front() override { return NULL; }
+
+        void insert(Activity* activity) override { pending.push_back(activity); }
+
+        /** Sending thread only */
+        void publish(SimTime_t promise);
+        /** Receiving thread only.  Moves any published events into vec. */
+        void take(std::vector<Activity*>& vec);
+
+        CACHE_ALIGNED(std::vector<Activity*>, pending);
+        CACHE_ALIGNED(Core::ThreadSafe::Spinlock, lock);
+        std::vector<Activity*> published;
+        std::atomic<SimTime_t> clock;
+        std::atomic<uint64_t> seq;
+    };
+
+    struct Partner {
+        int thread;
+        SimTime_t latency;
+        /** Latest clock seen on the incoming channel */
+        SimTime_t known;
+        /** Latest clock published on the outgoing channel */
+        SimTime_t promised;
+        uint64_t last_seq;
+        Channel* in;
+        Channel* out;
+    };
+
+    void deliver(std::vector<Activity*>& vec);
+    /** Pick up clocks and events from every partner.  Returns true
+     * if any clock moved. */
+    bool receive();
+    /** Publish pending events and the clock to every partner */
+    void send();
+    void computeNextSyncTime();
+
+    std::vector<Channel*> queues;
+    std::vector<Partner> partners;
+    std::unordered_map<LinkId_t, Link*> link_map;
+    int num_threads;
+    int thread;
+    Simulation* sim;
+    SimTime_t global_period;
+    SimTime_t next_global;
+    bool global_sync;
+    double totalWaitTime;
+    std::vector<Activity*> incoming;
+    std::vector<Activity*> tv_batch;
+    static Core::ThreadSafe::Barrier barrier;
+};
+
+
+} // namespace SST
+
+#endif // SST_CORE_THREADSYNCNULLMESSAGE_H
@@ -0,0 +1,405 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/threadSyncOptimistic.h"
+
+#include <algorithm>
+
+#include "sst/core/serialization/serializer.h"
+
+#include "sst/core/component.h"
+#include "sst/core/componentInfo.h"
+#include "sst/core/event.h"
+#include "sst/core/link.h"
+#include "sst/core/simulation.h"
+#include "sst/core/statapi/statengine.h"
+#include "sst/core/timeVortex.h"
+
+namespace SST {
+
+Core::ThreadSafe::Barrier ThreadSyncOptimistic::barrier[4];
+std::atomic<bool> ThreadSyncOptimistic::conflict(false);
+std::vector<char> ThreadSyncOptimistic::capable;
+std::vector<SimTime_t> ThreadSyncOptimistic::bounds;
+Exit::State ThreadSyncOptimistic::exit_state;
+
+/** Create a new ThreadSyncOptimistic object */
+ThreadSyncOptimistic::ThreadSyncOptimistic(int num_threads, int thread, Simulation* sim) :
+    NewThreadSync(),
+    num_threads(num_threads),
+    thread(thread),
+    sim(sim),
+    totalWaitTime(0.0),
+    checked(false),
+    speculating(false),
+    conservative_until(0),
+    commits(0),
+    rollbacks(0)
+{
+    for ( int i = 0; i < num_threads; i++ ) {
+        queues.push_back(new ThreadSyncQueue());
+    }
+
+    if ( thread == 0 ) {
+        for ( int i = 0; i < 4; i++ ) {
+            barrier[i].resize(num_threads);
+            barrier[i].setName("ThreadSyncOptimistic[" + std::to_string(i) + "]");
+        }
+        capable.assign(num_threads, 0);
+        bounds.assign(num_threads, MAX_SIMTIME_T);
+    }
+
+    my_max_period = sim->getInterThreadMinLatency();
+    window = my_max_period * initial_window;
+    nextSyncTime = my_max_period;
+    direct_delivery = sim->getThreadDirectDelivery();
+}
+
+ThreadSyncOptimistic::~ThreadSyncOptimistic()
+{
+    if ( totalWaitTime > 0.0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncOptimistic total wait time: %lg seconds.\n", totalWaitTime);
+    if ( commits > 0 || rollbacks > 0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncOptimistic windows committed: %" PRIu64 "  rolled back: %" PRIu64 "\n", commits, rollbacks);
+    for ( int i = 0; i < num_threads; i++ ) {
+        delete queues[i];
+    }
+    queues.clear();
+}
+
+void
+ThreadSyncOptimistic::registerLink(LinkId_t link_id, Link* link)
+{
+    link_map[link_id] = link;
+}
+
+ActivityQueue*
+ThreadSyncOptimistic::getQueueForThread(int tid)
+{
+    return queues[tid];
+}
+
+void
+ThreadSyncOptimistic::before()
+{
+    if ( direct_delivery ) {
+        // Events already carry their receiving Link
+        for ( size_t i = 0; i < queues.size(); i++ ) {
+            deliverDirect(queues[i]->getVector(), tv_batch);
+        }
+        flushDirect(tv_batch);
+        return;
+    }
+
+    // Empty all the queues and send events on the links
+    for ( size_t i = 0; i < queues.size(); i++ ) {
+        ThreadSyncQueue* queue = queues[i];
+        std::vector<Activity*>& vec = queue->getVector();
+        for ( size_t j = 0; j < vec.size(); j++ ) {
+            Event* ev = static_cast<Event*>(vec[j]);
+            auto link = link_map.find(ev->getLinkId());
+            if (link == link_map.end()) {
+                Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+            } else {
+                SimTime_t delay = ev->getDeliveryTime() - sim->getCurrentSimCycle();
+                link->second->send(delay,ev);
+            }
+        }
+        queue->clear();
+    }
+}
+
+void
+ThreadSyncOptimistic::after()
+{
+    // Same schedule as ThreadSyncSimpleSkip
+    if ( sim->getAdaptiveSync() ) {
+        nextSyncTime = sim->getLocalMinimumNextThreadSendTime();
+        return;
+    }
+
+    auto nextmin = sim->getLocalMinimumNextActivityTime();
+    auto nextminPlus = nextmin + my_max_period;
+    nextSyncTime = nextmin > nextminPlus ? nextmin : nextminPlus;
+}
+
+bool
+ThreadSyncOptimistic::canRollback()
+{
+    if ( StatisticProcessingEngine::getInstance()->hasStatistics() ) return false;
+    const ComponentInfoMap& infos = sim->getComponentInfoMap();
+    for ( auto iter = infos.begin(); iter != infos.end(); ++iter ) {
+        if ( !static_cast<Component*>((*iter)->getComponent())->supportsRollback() ) return false;
+    }
+    return true;
+}
+
+bool
+ThreadSyncOptimistic::hasStraggler(SimTime_t now)
+{
+    // Everything up to now has already run here, so any event timed
+    // before it arrived too late
+    for ( size_t i = 0; i < queues.size(); i++ ) {
+        std::vector<Activity*>& vec = queues[i]->getVector();
+        for ( size_t j = 0; j < vec.size(); j++ ) {
+            if ( vec[j]->getDeliveryTime() < now ) return true;
+        }
+    }
+    return false;
+}
+
+void
+ThreadSyncOptimistic::discardQueues()
+{
+    for ( size_t i = 0; i < queues.size(); i++ ) {
+        std::vector<Activity*>& vec = queues[i]->getVector();
+        for ( size_t j = 0; j < vec.size(); j++ ) {
+            delete vec[j];
+        }
+        queues[i]->clear();
+    }
+}
+
+SimTime_t
+ThreadSyncOptimistic::takeSnapshot()
+{
+    snapshot.time = sim->currentSimCycle;
+    snapshot.priority = sim->currentPriority;
+
+    // Empty the TimeVortex to see what is in it, then put it all back
+    // in the same order
+    TimeVortex* tv = sim->timeVortex;
+    std::vector<Activity*>& saved = snapshot.activities;
+    saved.clear();
+    while ( !tv->empty() ) saved.push_back(tv->pop());
+    tv->insertBatch(saved);
+
+    SimTime_t bound = MAX_SIMTIME_T;
+    std::vector<Activity*> events;
+    snapshot.event_links.clear();
+    for ( size_t i = 0; i < saved.size(); i++ ) {
+        Event* ev = dynamic_cast<Event*>(saved[i]);
+        if ( ev == NULL ) {
+            if ( saved[i]->getDeliveryTime() < bound ) bound = saved[i]->getDeliveryTime();
+            continue;
+        }
+        events.push_back(ev);
+        snapshot.event_links.push_back(ev->getDeliveryLink());
+        saved[i] = NULL;
+    }
+
+    SST::Core::Serialization::serializer ser;
+    ser.start_sizing();
+    ser & events;
+    snapshot.events.resize(ser.size());
+    ser.start_packing(snapshot.events.data(), snapshot.events.size());
+    ser & events;
+
+    const ComponentInfoMap& infos = sim->getComponentInfoMap();
+    ser.start_sizing();
+    for ( auto iter = infos.begin(); iter != infos.end(); ++iter ) {
+        static_cast<Component*>((*iter)->getComponent())->serializeState(ser);
+    }
+    snapshot.components.resize(ser.size());
+    ser.start_packing(snapshot.components.data(), snapshot.components.size());
+    for ( auto iter = infos.begin(); iter != infos.end(); ++iter ) {
+        static_cast<Component*>((*iter)->getComponent())->serializeState(ser);
+    }
+
+    snapshot.clock_scheduler = sim->clockScheduler;
+    snapshot.clocks.clear();
+    for ( auto& clock : sim->clockMap ) {
+        clock.second->saveState(snapshot.clocks[clock.second]);
+    }
+
+    return bound;
+}
+
+void
+ThreadSyncOptimistic::rollback()
+{
+    // Nothing sent during the window is valid
+    discardQueues();
+
+    TimeVortex* tv = sim->timeVortex;
+    std::vector<Activity*> added;
+    while ( !tv->empty() ) {
+        Activity* act = tv->pop();
+        if ( dynamic_cast<Event*>(act) != NULL ) delete act;
+        else added.push_back(act);
+    }
+
+    std::vector<Activity*> events;
+    SST::Core::Serialization::serializer ser;
+    ser.start_unpacking(snapshot.events.data(), snapshot.events.size());
+    ser & events;
+
+    // Put the saved Events back in their places.  Actions that were
+    // in the TimeVortex at the start of the window are all still
+    // there, since the window ends before any of them; anything else
+    // goes in after.
+    std::vector<Activity*> restored;
+    restored.reserve(snapshot.activities.size() + added.size());
+    size_t next_event = 0;
+    for ( size_t i = 0; i < snapshot.activities.size(); i++ ) {
+        Activity* act = snapshot.activities[i];
+        if ( act == NULL ) {
+            Event* ev = static_cast<Event*>(events[next_event]);
+            ev->setDeliveryLink(ev->getLinkId(), snapshot.event_links[next_event]);
+            next_event++;
+            restored.push_back(ev);
+        }
+        else {
+            restored.push_back(act);
+            auto iter = std::find(added.begin(), added.end(), act);
+            if ( iter != added.end() ) added.erase(iter);
+        }
+    }
+    restored.insert(restored.end(), added.begin(), added.end());
+    tv->insertBatch(restored);
+
+    const ComponentInfoMap& infos = sim->getComponentInfoMap();
+    ser.start_unpacking(snapshot.components.data(), snapshot.components.size());
+    for ( auto iter = infos.begin(); iter != infos.end(); ++iter ) {
+        static_cast<Component*>((*iter)->getComponent())->serializeState(ser);
+    }
+
+    // Clocks created during the window will be created again
+    sim->clockScheduler = snapshot.clock_scheduler;
+    for ( auto& clock : sim->clockMap ) {
+        auto state = snapshot.clocks.find(clock.second);
+        if ( state != snapshot.clocks.end() ) {
+            clock.second->restoreState(state->second);
+        }
+        else {
+            Clock::State empty = { 0, std::vector<Clock::HandlerBase*>(), 0, 0, false };
+            clock.second->restoreState(empty);
+        }
+    }
+
+    sim->currentSimCycle = snapshot.time;
+    sim->currentPriority = snapshot.priority;
+}
+
+void
+ThreadSyncOptimistic::execute()
+{
+    SimTime_t now = sim->getCurrentSimCycle();
+
+    if ( !checked ) capable[thread] = canRollback();
+
+    totalWaitTime += barrier[0].wait();
+
+    if ( !checked ) {
+        checked = true;
+        for ( int i = 0; i < num_threads; i++ ) {
+            if ( !capable[i] ) {
+                if ( thread == 0 ) {
+                    Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncOptimistic: thread %d has state that cannot be rolled back, running conservatively\n", i);
+                }
+                conservative_until = MAX_SIMTIME_T;
+                break;
+            }
+        }
+    }
+
+    if ( speculating ) {
+        speculating = false;
+        if ( hasStraggler(now) ) conflict.store(true, std::memory_order_relaxed);
+        totalWaitTime += barrier[1].wait();
+        if ( conflict.load(std::memory_order_relaxed) ) {
+            rollback();
+            if ( thread == 0 ) sim->getExit()->restoreState(exit_state);
+            conservative_until = now;
+            if ( window > my_max_period * 2 ) window /= 2;
+            rollbacks++;
+        }
+        else {
+            before();
+            if ( window < my_max_period * max_window ) window *= 2;
+            commits++;
+        }
+    }
+    else {
+        before();
+    }
+
+    totalWaitTime += barrier[2].wait();
+    if ( thread == 0 ) conflict.store(false, std::memory_order_relaxed);
+
+    // After a rollback this is the start of the window again.  The
+    // conservative schedule is worked out either way, since it looks
+    // at every thread and they are all stopped here.
+    now = sim->getCurrentSimCycle();
+    after();
+    bool speculate = now >= conservative_until;
+    if ( speculate ) {
+        bounds[thread] = takeSnapshot();
+        if ( thread == 0 ) sim->getExit()->saveState(exit_state);
+    }
+
+    totalWaitTime += barrier[3].wait();
+
+    if ( speculate ) {
+        // Every thread has to end the window at the same time, and
+        // before the next Action: a StopAction at the same time would
+        // run ahead of the sync.
+        SimTime_t end = now + window;
+        for ( int i = 0; i < num_threads; i++ ) {
+            if ( bounds[i] <= now ) end = now;
+            else if ( bounds[i] <= end ) end = bounds[i] - 1;
+        }
+        // Not worth it if the conservative schedule gets as far
+        if ( end > nextSyncTime ) {
+            speculating = true;
+            nextSyncTime = end;
+        }
+    }
+}
+
+void
+ThreadSyncOptimistic::processLinkUntimedData()
+{
+    // Need to walk through all the queues and send the data to the
+    // correct links
+    for ( int i = 0; i < num_threads; i++ ) {
+        ThreadSyncQueue* queue = queues[i];
+        std::vector<Activity*>& vec = queue->getVector();
+        for ( size_t j = 0; j < vec.size(); j++ ) {
+            Event* ev = static_cast<Event*>(vec[j]);
+            auto link = link_map.find(ev->getLinkId());
+            if (link == link_map.end()) {
+                Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+            } else {
+                sendUntimedData_sync(link->second,ev);
+            }
+        }
+        queue->clear();
+    }
+}
+
+void
+ThreadSyncOptimistic::finalizeLinkConfigurations() {
+    if ( direct_delivery ) resolveDirectQueues(link_map);
+    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
+        finalizeConfiguration(i->second);
+    }
+}
+
+void
+ThreadSyncOptimistic::prepareForComplete() {
+    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
+        prepareForCompleteInt(i->second);
+    }
+}
+
+} // namespace SST
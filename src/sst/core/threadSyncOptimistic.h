@@ -0,0 +1,128 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_THREADSYNCOPTIMISTIC_H
+#define SST_CORE_THREADSYNCOPTIMISTIC_H
+
+#include "sst/core/sst_types.h"
+
+#include <atomic>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "sst/core/clock.h"
+#include "sst/core/clockScheduler.h"
+#include "sst/core/exit.h"
+#include "sst/core/syncManager.h"
+#include "sst/core/threadsafe.h"
+#include "sst/core/threadSyncQueue.h"
+
+namespace SST {
+
+class Link;
+class Simulation;
+
+/**
+ * Optimistic thread synchronization.  Threads run a window of many
+ * lookaheads without stopping, holding back the events they send to
+ * each other, after saving their state at the start of the window.
+ * At the end of the window, if no thread was sent an event timed
+ * inside the window, the held events are delivered and the window
+ * commits.  Otherwise every thread restores its saved state and the
+ * window is run again with ThreadSyncSimpleSkip's conservative
+ * schedule.  Since events never leave a window before it commits, a
+ * rollback never has to chase them with anti-messages, and the start
+ * of the current window is the global virtual time: nothing older is
+ * kept.
+ *
+ * The window doubles on every commit and halves on every rollback.
+ * It never passes an Action other than an Event, such as a StopAction
+ * or the heartbeat, so those only ever run on committed state.
+ *
+ * Component state is saved through Component::serializeState().  If
+ * any component on the rank does not support rollback, or
+ * statistics are enabled, the rank stays conservative.
+ */
+class ThreadSyncOptimistic : public NewThreadSync {
+public:
+    /** Create a new ThreadSync object */
+    ThreadSyncOptimistic(int num_threads, int thread, Simulation* sim);
+    ~ThreadSyncOptimistic();
+
+    void before() override;
+    void after() override;
+    void execute(void) override;
+
+    /** Cause an exchange of Untimed Data to occur */
+    void processLinkUntimedData() override;
+    /** Finish link configuration */
+    void finalizeLinkConfigurations() override;
+    void prepareForComplete() override;
+
+    /** Register a Link which this Sync Object is responsible for */
+    void registerLink(LinkId_t link_id, Link* link) override;
+    ActivityQueue* getQueueForThread(int tid) override;
+
+private:
+    /** Everything needed to put this thread back where it was at the
+     * start of a window */
+    struct Snapshot {
+        SimTime_t time;
+        int priority;
+        /** The TimeVortex in order.  Events are stored serialized in
+         * events; their place is held by a NULL. */
+        std::vector<Activity*> activities;
+        std::vector<Link*> event_links;
+        std::vector<char> events;
+        std::vector<char> components;
+        ClockScheduler clock_scheduler;
+        std::map<Clock*, Clock::State> clocks;
+    };
+
+    enum { initial_window = 8, max_window = 1024 };
+
+    bool canRollback();
+    bool hasStraggler(SimTime_t now);
+    /** Returns the earliest Action in the TimeVortex that is not an
+     * Event, which bounds the window */
+    SimTime_t takeSnapshot();
+    void rollback();
+    void discardQueues();
+
+    std::vector<ThreadSyncQueue*> queues;
+    std::unordered_map<LinkId_t, Link*> link_map;
+    SimTime_t my_max_period;
+    int num_threads;
+    int thread;
+    Simulation* sim;
+    double totalWaitTime;
+    std::vector<Activity*> tv_batch;
+
+    bool checked;
+    bool speculating;
+    SimTime_t window;
+    SimTime_t conservative_until;
+    Snapshot snapshot;
+    uint64_t commits;
+    uint64_t rollbacks;
+
+    static Core::ThreadSafe::Barrier barrier[4];
+    static std::atomic<bool> conflict;
+    static std::vector<char> capable;
+    static std::vector<SimTime_t> bounds;
+    static Exit::State exit_state;
+};
+
+
+} // namespace SST
+
+#endif // SST_CORE_THREADSYNCOPTIMISTIC_H
@@ -0,0 +1,258 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/threadSyncPairwise.h"
+
+#include <time.h>
+
+#include "sst/core/event.h"
+#include "sst/core/link.h"
+#include "sst/core/profile.h"
+#include "sst/core/simulation.h"
+
+namespace SST {
+
+Core::ThreadSafe::Barrier ThreadSyncPairwise::barrier;
+
+/** Create a new ThreadSyncPairwise object */
+ThreadSyncPairwise::ThreadSyncPairwise(int num_threads, int thread, Simulation* sim, bool check_exit) :
+    NewThreadSync(),
+    num_threads(num_threads),
+    thread(thread),
+    sim(sim),
+    global_sync(false),
+    totalWaitTime(0.0)
+{
+    for ( int i = 0; i < num_threads; i++ ) {
+        queues.push_back(new PairQueue());
+    }
+
+    if ( thread == 0 ) {
+        barrier.resize(num_threads);
+        barrier.setName("ThreadSyncPairwise");
+    }
+
+    // Each pair of threads syncs at multiples of the smallest latency
+    // between them.  Both sides compute the same schedule, which is
+    // what keeps their handshake counts in step.
+    const std::vector<SimTime_t>& latencies = sim->getInterThreadLatencies();
+    for ( int i = 0; i < num_threads; i++ ) {
+        if ( i == thread || latencies[i] == MAX_SIMTIME_T ) continue;
+        Partner p;
+        p.thread = i;
+        p.period = latencies[i];
+        p.next = latencies[i];
+        p.in = queues[i];
+        p.out = NULL;
+        partners.push_back(p);
+    }
+
+    // With only one rank, exit is detected during thread syncs and
+    // needs every thread stopped.  Do that every num_threads windows
+    // of the rank-wide lookahead; this bounds how far past the exit
+    // time we run.  With more ranks the rank sync handles exit.
+    if ( check_exit ) {
+        global_period = sim->getInterThreadMinLatency() * num_threads;
+    }
+    else {
+        global_period = MAX_SIMTIME_T;
+    }
+    next_global = global_period;
+
+    direct_delivery = sim->getThreadDirectDelivery();
+    computeNextSyncTime();
+}
+
+ThreadSyncPairwise::~ThreadSyncPairwise()
+{
+    if ( totalWaitTime > 0.0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "ThreadSyncPairwise total wait time: %lg seconds.\n", totalWaitTime);
+    for ( int i = 0; i < num_threads; i++ ) {
+        delete queues[i];
+    }
+    queues.clear();
+}
+
+void
+ThreadSyncPairwise::registerLink(LinkId_t link_id, Link* link)
+{
+    link_map[link_id] = link;
+}
+
+void
+ThreadSyncPairwise::registerRemoteQueue(int tid, ActivityQueue* queue)
+{
+    for ( auto& p : partners ) {
+        if ( p.thread == tid ) {
+            p.out = static_cast<PairQueue*>(queue);
+            return;
+        }
+    }
+}
+
+ActivityQueue*
+ThreadSyncPairwise::getQueueForThread(int tid)
+{
+    return queues[tid];
+}
+
+void
+ThreadSyncPairwise::deliver(std::vector<Activity*>& vec)
+{
+    if ( direct_delivery ) {
+        // Events already carry their receiving Link; the caller
+        // inserts tv_batch once every partner has been drained
+        deliverDirect(vec, tv_batch);
+        return;
+    }
+    for ( size_t j = 0; j < vec.size(); j++ ) {
+        Event* ev = static_cast<Event*>(vec[j]);
+        auto link = link_map.find(ev->getLinkId());
+        if (link == link_map.end()) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+        } else {
+            SimTime_t delay = ev->getDeliveryTime() - sim->getCurrentSimCycle();
+            link->second->send(delay,ev);
+        }
+    }
+    vec.clear();
+}
+
+void
+ThreadSyncPairwise::before()
+{
+    // Called with every thread stopped for a rank sync, so both
+    // buffers can be emptied.  Older buffer first.
+    for ( auto& p : partners ) {
+        uint64_t epoch = p.out->posted.load(std::memory_order_relaxed);
+        deliver(p.in->buf[(epoch + 1) & 1]);
+        deliver(p.in->buf[epoch & 1]);
+    }
+    flushDirect(tv_batch);
+}
+
+void
+ThreadSyncPairwise::after()
+{
+    // Every thread skips the pair syncs that fell on the rank sync,
+    // so the handshake counts stay matched.
+    SimTime_t now = sim->getCurrentSimCycle();
+    for ( auto& p : partners ) {
+        if ( p.next <= now ) p.next = (now / p.period + 1) * p.period;
+    }
+    if ( next_global <= now ) next_global = (now / global_period + 1) * global_period;
+    computeNextSyncTime();
+}
+
+void
+ThreadSyncPairwise::execute()
+{
+    SimTime_t now = sim->getCurrentSimCycle();
+
+    // Post to every partner due now before waiting on any of them
+    for ( auto& p : partners ) {
+        if ( p.next == now ) p.out->posted.fetch_add(1, std::memory_order_release);
+    }
+
+    for ( auto& p : partners ) {
+        if ( p.next != now ) continue;
+        uint64_t epoch = p.out->posted.load(std::memory_order_relaxed);
+        if ( p.in->posted.load(std::memory_order_acquire) < epoch ) {
+            auto startTime = SST::Core::Profile::now();
+            uint32_t count = 0;
+            do {
+                count++;
+                if ( count < 1024 ) {
+#if ( defined( __amd64 ) || defined( __amd64__ ) || \
+        defined( __x86_64 ) || defined( __x86_64__ ) )
+                    _mm_pause();
+#elif defined(__PPC64__)
+                    asm volatile( "or 27, 27, 27" ::: "memory" );
+#endif
+                } else if ( count < (1024*1024) ) {
+                    std::this_thread::yield();
+                } else {
+                    struct timespec ts;
+                    ts.tv_sec = 0;
+                    ts.tv_nsec = 1000;
+                    nanosleep(&ts, NULL);
+                }
+            } while ( p.in->posted.load(std::memory_order_acquire) < epoch );
+            totalWaitTime += SST::Core::Profile::getElapsed(startTime);
+        }
+        // The partner has moved on to the other buffer; this one
+        // holds everything it sent before this handshake.
+        deliver(p.in->buf[(epoch - 1) & 1]);
+        p.next += p.period;
+    }
+    flushDirect(tv_batch);
+
+    global_sync = ( now == next_global );
+    if ( global_sync ) {
+        totalWaitTime += barrier.wait();
+        next_global += global_period;
+    }
+
+    computeNextSyncTime();
+}
+
+void
+ThreadSyncPairwise::computeNextSyncTime()
+{
+    nextSyncTime = next_global;
+    for ( auto& p : partners ) {
+        if ( p.next < nextSyncTime ) nextSyncTime = p.next;
+    }
+}
+
+void
+ThreadSyncPairwise::processLinkUntimedData()
+{
+    // Need to walk through all the queues and send the data to the
+    // correct links
+    for ( int i = 0; i < num_threads; i++ ) {
+        for ( auto& vec : queues[i]->buf ) {
+            for ( size_t j = 0; j < vec.size(); j++ ) {
+                Event* ev = static_cast<Event*>(vec[j]);
+                auto link = link_map.find(ev->getLinkId());
+                if (link == link_map.end()) {
+                    Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+                } else {
+                    sendUntimedData_sync(link->second,ev);
+                }
+            }
+            vec.clear();
+        }
+    }
+}
+
+void
+ThreadSyncPairwise::finalizeLinkConfigurations() {
+    if ( direct_delivery ) resolveDirectQueues(link_map);
+    for ( auto& p : partners ) {
+        if ( p.out == NULL ) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Thread %d has no link queue on partner thread %d\n", thread, p.thread);
+        }
+    }
+    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
+        finalizeConfiguration(i->second);
+    }
+}
+
+void
+ThreadSyncPairwise::prepareForComplete() {
+    for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
+        prepareForCompleteInt(i->second);
+    }
+}
+
+} // namespace SST
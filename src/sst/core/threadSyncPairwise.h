@@ -0,0 +1,115 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_THREADSYNCPAIRWISE_H
+#define SST_CORE_THREADSYNCPAIRWISE_H
+
+#include "sst/core/sst_types.h"
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+#include "sst/core/activityQueue.h"
+#include "sst/core/syncManager.h"
+#include "sst/core/threadsafe.h"
+
+namespace SST {
+
+class Link;
+class Simulation;
+
+/**
+ * Thread synchronization that only waits on the threads this thread
+ * actually shares links with.  Each pair of linked threads exchanges
+ * events every P simulated cycles, where P is the minimum latency of
+ * the links between them, using a pair of counters instead of an
+ * all-thread barrier.  A rank-wide barrier is still needed every so
+ * often to check for exit, since endSimulation() is collective.
+ */
+class ThreadSyncPairwise : public NewThreadSync {
+public:
+    /** Create a new ThreadSync object.  check_exit is true when no
+     * rank sync will run, so this sync has to make room for the exit
+     * check. */
+    ThreadSyncPairwise(int num_threads, int thread, Simulation* sim, bool check_exit);
+    ~ThreadSyncPairwise();
+
+    void before() override;
+    void after() override;
+    void execute(void) override;
+    bool isGlobalSync() override { return global_sync; }
+
+    /** Cause an exchange of Untimed Data to occur */
+    void processLinkUntimedData() override;
+    /** Finish link configuration */
+    void finalizeLinkConfigurations() override;
+    void prepareForComplete() override;
+
+    /** Register a Link which this Sync Object is responsible for */
+    void registerLink(LinkId_t link_id, Link* link) override;
+    void registerRemoteQueue(int tid, ActivityQueue* queue) override;
+    ActivityQueue* getQueueForThread(int tid) override;
+
+private:
+    /**
+     * Events sent to this thread by one other thread.  The sender
+     * fills the buffer selected by the number of handshakes it has
+     * posted, so the receiver can drain the previous buffer while
+     * the sender keeps going.  Only the sending thread writes posted.
+     */
+    class PairQueue : public ActivityQueue {
+    public:
+        PairQueue() : ActivityQueue(), posted(0) {}
+        ~PairQueue() {}
+
+        bool empty() override { return buf[0].empty() && buf[1].empty(); }
+        int size() override { return buf[0].size() + buf[1].size(); }
+        Activity* pop() override { return NULL; }
+        Activity* front() override { return NULL; }
+
+        void insert(Activity* activity) override {
+            buf[posted.load(std::memory_order_relaxed) & 1].push_back(activity);
+        }
+
+        CACHE_ALIGNED(std::atomic<uint64_t>, posted);
+        CACHE_ALIGNED(std::vector<Activity*>, buf[2]);
+    };
+
+    struct Partner {
+        int thread;
+        SimTime_t period;
+        SimTime_t next;
+        PairQueue* in;
+        PairQueue* out;
+    };
+
+    void deliver(std::vector<Activity*>& vec);
+    void computeNextSyncTime();
+
+    std::vector<PairQueue*> queues;
+    std::vector<Partner> partners;
+    std::unordered_map<LinkId_t, Link*> link_map;
+    int num_threads;
+    int thread;
+    Simulation* sim;
+    SimTime_t global_period;
+    SimTime_t next_global;
+    bool global_sync;
+    double totalWaitTime;
+    std::vector<Activity*> tv_batch;
+    static Core::ThreadSafe::Barrier barrier;
+};
+
+
+} // namespace SST
+
+#endif // SST_CORE_THREADSYNCPAIRWISE_H
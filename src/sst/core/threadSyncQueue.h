@@ -14,6 +14,7 @@
 #define SST_CORE_THREADSYNCQUEUE_H
 
 #include <sst/core/activityQueue.h>
+#include <sst/core/event.h>
 
 namespace SST {
 
@@ -65,6 +66,57 @@ private:
     std::vector<Activity*> activities;
     
 };
+
+/** Queue for one cross-thread link when events are delivered
+ * directly.  The sending thread tags each event with the Link that
+ * receives it, then passes it on to the queue for the thread pair.
+ */
+class ThreadSyncDirectQueue : public ActivityQueue {
+public:
+    ThreadSyncDirectQueue(ActivityQueue* queue) :
+        ActivityQueue(),
+        queue(queue),
+        target(NULL)
+        {}
+    ~ThreadSyncDirectQueue() {}
+
+    /** Returns true if the queue is empty */
+    bool empty() override {
+        return queue->empty();
+    }
+
+    /** Returns the number of activities in the queue */
+    int size() override {
+        return queue->size();
+    }
+
+    /** Not supported */
+    Activity* pop() override {
+        return NULL;
+    }
+
+    /** Insert a new activity into the queue */
+    void insert(Activity* activity) override {
+        Event* ev = static_cast<Event*>(activity);
+        ev->setDeliveryLink(ev->getLinkId(), target);
+        queue->insert(ev);
+    }
+
+    /** Not supported */
+    Activity* front() override {
+        return NULL;
+    }
+
+    /** Set the Link on the receiving thread.  Not known until every
+     * thread has finished wireup. */
+    void setTarget(Link* link) {
+        target = link;
+    }
+
+private:
+    ActivityQueue* queue;
+    Link* target;
+};
  
 } //namespace SST
 
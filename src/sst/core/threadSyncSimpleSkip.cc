@@ -40,6 +40,9 @@ ThreadSyncSimpleSkip::ThreadSyncSimpleSkip(int num_threads, int thread, Simulati
         barrier[0].resize(num_threads);
         barrier[1].resize(num_threads);
         barrier[2].resize(num_threads);
+        barrier[0].setName("ThreadSyncSimpleSkip[0]");
+        barrier[1].setName("ThreadSyncSimpleSkip[1]");
+        barrier[2].setName("ThreadSyncSimpleSkip[2]");
     }
 
     if ( sim->getNumRanks().rank > 1 ) single_rank = false;
@@ -47,6 +50,8 @@ ThreadSyncSimpleSkip::ThreadSyncSimpleSkip(int num_threads, int thread, Simulati
 
     my_max_period = sim->getInterThreadMinLatency();
     nextSyncTime = my_max_period;
+    direct_delivery = sim->getThreadDirectDelivery();
+    adaptive = sim->getAdaptiveSync();
 }
 
 ThreadSyncSimpleSkip::~ThreadSyncSimpleSkip()
@@ -74,6 +79,15 @@ ThreadSyncSimpleSkip::getQueueForThread(int tid)
 void
 ThreadSyncSimpleSkip::before()
 {
+    if ( direct_delivery ) {
+        // Events already carry their receiving Link
+        for ( size_t i = 0; i < queues.size(); i++ ) {
+            deliverDirect(queues[i]->getVector(), tv_batch);
+        }
+        flushDirect(tv_batch);
+        return;
+    }
+
     // Empty all the queues and send events on the links
     for ( size_t i = 0; i < queues.size(); i++ ) {
         ThreadSyncQueue* queue = queues[i];
@@ -100,6 +114,13 @@ ThreadSyncSimpleSkip::after()
 
     // Use this nextSyncTime computation for skipping
 
+    // Use this nextSyncTime computation to skip straight to the
+    // first time any thread could send to another
+    if ( adaptive ) {
+        nextSyncTime = sim->getLocalMinimumNextThreadSendTime();
+        return;
+    }
+
     auto nextmin = sim->getLocalMinimumNextActivityTime();
     auto nextminPlus = nextmin + my_max_period;
     nextSyncTime = nextmin > nextminPlus ? nextmin : nextminPlus;
@@ -138,6 +159,7 @@ ThreadSyncSimpleSkip::processLinkUntimedData()
 
 void
 ThreadSyncSimpleSkip::finalizeLinkConfigurations() {
+    if ( direct_delivery ) resolveDirectQueues(link_map);
     for (auto i = link_map.begin() ; i != link_map.end() ; ++i) {
         finalizeConfiguration(i->second);
     }
@@ -67,6 +67,8 @@ private:
     static Core::ThreadSafe::Barrier barrier[3];
     double totalWaitTime;
     bool single_rank;
+    bool adaptive;
+    std::vector<Activity*> tv_batch;
 };
 
 
@@ -22,11 +22,22 @@
 #include <condition_variable>
 #include <mutex>
 
+#include <climits>
+#include <cstdlib>
+#include <new>
+#include <string>
 #include <vector>
 //#include <stdalign.h>
 
 #include <time.h>
 
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define SST_CORE_BARRIER_FUTEX 1
+#endif
+
 #include <sst/core/profile.h>
 
 namespace SST {
@@ -42,28 +53,230 @@ namespace ThreadSafe {
 #endif
 
 
+/**
+ * Barrier for the threads of a rank.
+ *
+ * Arrivals are combined in a tree with a fan-in of 4, so each thread
+ * only touches the counter of its own group; the last thread up the
+ * tree releases everyone by bumping the generation.  Waiters poll the
+ * generation for the spin budget, then sleep on it with a futex (or
+ * nanosleep where futexes are not available).
+ *
+ * A thread's place in the tree comes from setThreadIndex(), which the
+ * core calls as each simulation thread starts.  Threads that never
+ * set an index are placed in arrival order instead; a barrier must
+ * not mix the two.
+ */
 class CACHE_ALIGNED_T Barrier {
+    enum { fanin = 4 };
+
+    struct CACHE_ALIGNED_T Node {
+        std::atomic<uint32_t> count;
+        uint32_t size;
+        long parent;            /*!< -1 for the root */
+    };
+
+    /** Per thread statistics, only written by the owning thread */
+    struct CACHE_ALIGNED_T Slot {
+        double waitTime;
+        uint64_t waits;
+    };
+
     size_t origCount;
     std::atomic<bool> enabled;
-    std::atomic<size_t> count, generation;
+    Node* nodes;
+    Slot* slots;
+    std::atomic<size_t> ticket;
+    std::string name;
+    CACHE_ALIGNED(std::atomic<uint32_t>, generation);
+    std::atomic<uint32_t> sleepers;
+
+    static int& threadIndexRef() {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    static uint32_t& spinBudgetRef() {
+        static uint32_t budget = 1024;
+        return budget;
+    }
+
+    static std::mutex& registryMutex() {
+        static std::mutex mtx;
+        return mtx;
+    }
+
+    static std::vector<Barrier*>& registry() {
+        static std::vector<Barrier*> barriers;
+        return barriers;
+    }
+
+    /** new[] does not honor the 64 byte alignment before C++17 */
+    template<typename T>
+    static T* allocAligned(size_t count)
+    {
+        void* mem = NULL;
+        if ( 0 != posix_memalign(&mem, 64, count * sizeof(T)) ) throw std::bad_alloc();
+        T* array = static_cast<T*>(mem);
+        for ( size_t i = 0; i < count; i++ ) new (&array[i]) T();
+        return array;
+    }
+
+    void build()
+    {
+        free(nodes);
+        free(slots);
+        nodes = NULL;
+        slots = NULL;
+        if ( origCount == 0 ) return;
+
+        // Leaves first, then each level above them, root last
+        std::vector<size_t> levelSize;
+        size_t n = origCount;
+        do {
+            n = (n + fanin - 1) / fanin;
+            levelSize.push_back(n);
+        } while ( n > 1 );
+
+        size_t total = 0;
+        for ( auto l : levelSize ) total += l;
+        nodes = allocAligned<Node>(total);
+        slots = allocAligned<Slot>(origCount);
+
+        size_t offset = 0;
+        size_t below = origCount;
+        for ( size_t l = 0; l < levelSize.size(); l++ ) {
+            size_t next = offset + levelSize[l];
+            for ( size_t k = 0; k < levelSize[l]; k++ ) {
+                Node& node = nodes[offset + k];
+                size_t size = below - k * fanin;
+                node.size = (uint32_t)(size < (size_t)fanin ? size : (size_t)fanin);
+                node.count.store(node.size);
+                node.parent = ( l + 1 < levelSize.size() ) ? (long)(next + k / fanin) : -1;
+            }
+            below = levelSize[l];
+            offset = next;
+        }
+        for ( size_t i = 0; i < origCount; i++ ) {
+            slots[i].waitTime = 0.0;
+            slots[i].waits = 0;
+        }
+    }
+
+    void release()
+    {
+        generation.fetch_add(1);
+        if ( sleepers.load() != 0 ) {
+#ifdef SST_CORE_BARRIER_FUTEX
+            syscall(SYS_futex, &generation, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#endif
+        }
+    }
+
+    void block(uint32_t gen)
+    {
+        uint32_t budget = spinBudgetRef();
+        uint32_t spins = 0;
+        while ( gen == generation.load(std::memory_order_acquire) ) {
+            if ( spins < budget ) {
+                spins++;
+#if ( defined( __amd64 ) || defined( __amd64__ ) || \
+        defined( __x86_64 ) || defined( __x86_64__ ) )
+                _mm_pause();
+#elif defined(__PPC64__)
+                asm volatile( "or 27, 27, 27" ::: "memory" );
+#endif
+                continue;
+            }
+            sleepers.fetch_add(1);
+#ifdef SST_CORE_BARRIER_FUTEX
+            // Returns at once if the generation has already moved on
+            syscall(SYS_futex, &generation, FUTEX_WAIT_PRIVATE, gen, NULL, NULL, 0);
+#else
+            struct timespec ts;
+            ts.tv_sec = 0;
+            ts.tv_nsec = 1000;
+            nanosleep(&ts, NULL);
+#endif
+            sleepers.fetch_sub(1);
+        }
+    }
+
 public:
     Barrier(size_t count) : origCount(count), enabled(true),
-            count(count), generation(0)
-    { }
+            nodes(NULL), slots(NULL), ticket(0), generation(0), sleepers(0)
+    {
+        build();
+    }
 
     // Come g++ 4.7, this can become a delegating constructor
-    Barrier() : origCount(0), enabled(false), count(0), generation(0)
+    Barrier() : origCount(0), enabled(false),
+            nodes(NULL), slots(NULL), ticket(0), generation(0), sleepers(0)
     { }
 
+    ~Barrier()
+    {
+        if ( !name.empty() ) {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            std::vector<Barrier*>& r = registry();
+            for ( auto it = r.begin(); it != r.end(); ++it ) {
+                if ( *it == this ) { r.erase(it); break; }
+            }
+        }
+        free(nodes);
+        free(slots);
+    }
 
     /** ONLY call this while nobody is in wait() */
     void resize(size_t newCount)
     {
-        count = origCount = newCount;
+        origCount = newCount;
+        build();
+        ticket.store(0);
         generation.store(0);
         enabled.store(true);
     }
 
+    /** Name the barrier so its wait statistics can be reported */
+    void setName(const std::string& newName)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        if ( name.empty() ) registry().push_back(this);
+        name = newName;
+    }
+
+    const std::string& getName() const { return name; }
+
+    /** Set the calling thread's position in every Barrier */
+    static void setThreadIndex(int index) { threadIndexRef() = index; }
+
+    /** Set how many times a waiting thread polls before it sleeps */
+    static void setSpinBudget(uint32_t budget) { spinBudgetRef() = budget; }
+    static uint32_t getSpinBudget() { return spinBudgetRef(); }
+
+    /** Barriers that have been given a name */
+    static std::vector<Barrier*> getNamedBarriers()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        return registry();
+    }
+
+    /** Total time spent waiting, summed over threads.  Only recorded
+     * when configured with --enable-profile */
+    double getWaitTime() const
+    {
+        double total = 0.0;
+        for ( size_t i = 0; slots && i < origCount; i++ ) total += slots[i].waitTime;
+        return total;
+    }
+
+    /** Number of times a thread has waited on this barrier */
+    uint64_t getWaitCount() const
+    {
+        uint64_t total = 0;
+        for ( size_t i = 0; slots && i < origCount; i++ ) total += slots[i].waits;
+        return total;
+    }
 
     /**
      * Wait for all threads to reach this point.
@@ -72,42 +285,34 @@ public:
     double wait()
     {
         double elapsed = 0.0;
-        if ( enabled ) {
+        if ( enabled && origCount != 0 ) {
             auto startTime = SST::Core::Profile::now();
 
-            size_t gen = generation.load(std::memory_order_acquire);
+            size_t index = threadIndexRef();
+            if ( index >= origCount ) index = ticket.fetch_add(1) % origCount;
+
+            uint32_t gen = generation.load(std::memory_order_acquire);
             asm("":::"memory");
-            size_t c = count.fetch_sub(1) -1;
-            if ( 0 == c ) {
-                /* We should release */
-                count.store(origCount);
-                asm("":::"memory");
-                /* Incrementing generation causes release */
-                generation.fetch_add(1, std::memory_order_release);
-                __sync_synchronize();
-            } else {
-                /* Try spinning first */
-                uint32_t count = 0;
-                do {
-                    count++;
-                    if ( count < 1024 ) {
-#if ( defined( __amd64 ) || defined( __amd64__ ) || \
-        defined( __x86_64 ) || defined( __x86_64__ ) )
-                        _mm_pause();
-#elif defined(__PPC64__)
-       	asm volatile( "or 27, 27, 27" ::: "memory" );
-#endif
-		    } else if ( count < (1024*1024) ) {
-                        std::this_thread::yield();
-                    } else {
-                        struct timespec ts;
-                        ts.tv_sec = 0;
-                        ts.tv_nsec = 1000;
-                        nanosleep(&ts, NULL);
-                    }
-                } while ( gen == generation.load(std::memory_order_acquire) );
+
+            // Climb while we are the last to arrive at a node
+            size_t n = index / fanin;
+            while ( true ) {
+                Node& node = nodes[n];
+                if ( node.count.fetch_sub(1, std::memory_order_acq_rel) != 1 ) {
+                    block(gen);
+                    break;
+                }
+                node.count.store(node.size, std::memory_order_relaxed);
+                if ( node.parent < 0 ) {
+                    release();
+                    break;
+                }
+                n = node.parent;
             }
+
             elapsed = SST::Core::Profile::getElapsed(startTime);
+            slots[index].waitTime += elapsed;
+            slots[index].waits++;
         }
         return elapsed;
     }
@@ -115,8 +320,7 @@ public:
     void disable()
     {
         enabled.store(false);
-        count.store(0);
-        ++generation;
+        release();
     }
 };
 
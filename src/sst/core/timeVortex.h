@@ -12,6 +12,8 @@
 #ifndef SST_CORE_TIMEVORTEX_H
 #define SST_CORE_TIMEVORTEX_H
 
+#include <vector>
+
 #include <sst/core/activityQueue.h>
 #include <sst/core/module.h>
 
@@ -28,7 +30,11 @@ public:
   SST_ELI_DECLARE_INFO_EXTERN(ELI::ProvidesParams)
   SST_ELI_DECLARE_CTOR_EXTERN(SST::Params&)
 
-	TimeVortex() {
+	TimeVortex() :
+        batch_time(MAX_SIMTIME_T),
+        batch_priority(0),
+        batch_interrupted(false)
+    {
         max_depth = MAX_SIMTIME_T;
     }
     ~TimeVortex() {}
@@ -40,6 +46,30 @@ public:
     virtual Activity* pop() override = 0;
     virtual Activity* front() override = 0;
 
+    /** Insert each activity in order.  Same result as calling
+     * insert() on each, but lets an implementation take the whole
+     * batch at once. */
+    virtual void insertBatch(std::vector<Activity*>& activities) {
+        for ( size_t i = 0; i < activities.size(); i++ ) insert(activities[i]);
+    }
+
+    /** Remove the next activity, along with every following activity
+     * with the same delivery time and priority, and append them in
+     * order to batch.  Implementations that return more than one
+     * activity must call startBatch() here and checkBatch() from
+     * insert().  The default returns a single activity.
+     */
+    virtual void popBatch(std::vector<Activity*>& batch) { batch.push_back(pop()); }
+
+    /** Return an activity taken by popBatch() to the queue without
+     * changing its queue order */
+    virtual void requeue(Activity* activity) { insert(activity); }
+
+    /** Returns true if an activity has been inserted with the same
+     * delivery time and priority as the current batch.  The rest of
+     * the batch must then be requeued so it is ordered with it. */
+    bool batchInterrupted() const { return batch_interrupted; }
+
     /** Print the state of the TimeVortex */
     virtual void print(Output &out) const = 0;
     virtual uint64_t getMaxDepth() const { return max_depth; }
@@ -47,8 +77,25 @@ public:
 
     
 protected:
+    void startBatch(SimTime_t time, int priority) {
+        batch_time = time;
+        batch_priority = priority;
+        batch_interrupted = false;
+    }
+
+    inline void checkBatch(Activity* activity) {
+        if ( UNLIKELY(activity->getDeliveryTime() == batch_time && activity->getPriority() == batch_priority) ) {
+            batch_interrupted = true;
+        }
+    }
+
     uint64_t max_depth;
-    
+
+private:
+    SimTime_t batch_time;
+    int batch_priority;
+    bool batch_interrupted;
+
 };
 
 } //namespace SST